@@ -0,0 +1,270 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Micro benchmark for the collector hot paths.
+ /// @details Runs every case for a fixed number of iterations and reports the time,
+ /// heap allocations and read/write calls per iteration; use --json for machine readable output.
+ /// The calls are the 'syscr' and 'syscw' counters from /proc/self/io: only the read and write
+ /// families (read, pread, readv, write, ...) are counted, open, close, lseek and every other
+ /// system call are not.
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <udjat/tools/storage/stat.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/agent/memusage.h>
+ #include <udjat/agent/loadavg.h>
+ #include <private/storagecontroller.h>
+ #include <private/processtable.h>
+
+ #include <atomic>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <cstring>
+ #include <functional>
+ #include <new>
+ #include <fcntl.h>
+ #include <unistd.h>
+
+ using namespace Udjat;
+ using namespace std;
+
+ static std::atomic<unsigned long long> allocations{0};
+
+ void * operator new(size_t size) {
+	allocations++;
+	void *ptr = malloc(size ? size : 1);
+	if(!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+ }
+
+ void operator delete(void *ptr) noexcept {
+	free(ptr);
+ }
+
+ void operator delete(void *ptr, size_t) noexcept {
+	free(ptr);
+ }
+
+ /// @brief Get the number of read and write calls (syscr + syscw) from /proc/self/io.
+ static unsigned long long rwcalls() {
+
+	static int fd = -1;
+	if(fd < 0) {
+		fd = open("/proc/self/io",O_RDONLY|O_CLOEXEC);
+		if(fd < 0) {
+			return 0;
+		}
+	}
+
+	char buffer[512];
+	ssize_t bytes = pread(fd,buffer,sizeof(buffer)-1,0);
+	if(bytes <= 0) {
+		return 0;
+	}
+	buffer[bytes] = 0;
+
+	unsigned long long rc = 0;
+	for(const char *key : { "syscr:", "syscw:" }) {
+		const char *ptr = strstr(buffer,key);
+		if(ptr) {
+			rc += strtoull(ptr+strlen(key),nullptr,10);
+		}
+	}
+
+	return rc;
+
+ }
+
+ struct Result {
+	const char *name;
+	unsigned long iterations;
+	double ns;
+	double allocations;
+	double rwcalls;
+ };
+
+ static Result run(const char *name, unsigned long iterations, const std::function<void()> &method) {
+
+	// Warm up, the first call usually opens files and allocates buffers.
+	method();
+
+	// Calibrate, reading /proc/self/io is itself a read.
+	unsigned long long overhead = rwcalls();
+	overhead = rwcalls() - overhead;
+
+	unsigned long long alloc = allocations;
+	unsigned long long calls = rwcalls();
+	auto start = std::chrono::steady_clock::now();
+
+	for(unsigned long ix = 0; ix < iterations; ix++) {
+		method();
+	}
+
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	calls = rwcalls() - calls - overhead;
+	alloc = allocations - alloc;
+
+	return Result{
+		name,
+		iterations,
+		((double) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations,
+		((double) alloc) / iterations,
+		((double) calls) / iterations
+	};
+
+ }
+
+ int main(int argc, char **argv) {
+
+	bool json = false;
+	unsigned long iterations = 1000;
+
+	for(int arg = 1; arg < argc; arg++) {
+		if(!strcmp(argv[arg],"--json")) {
+			json = true;
+		} else if(!strncmp(argv[arg],"--iterations=",13)) {
+			iterations = strtoul(argv[arg]+13,nullptr,10);
+		} else {
+			fprintf(stderr,"Usage: %s [--json] [--iterations=N]\n",argv[0]);
+			return -1;
+		}
+	}
+
+	if(!iterations) {
+		iterations = 1;
+	}
+
+	std::vector<Result> results;
+
+	try {
+
+		results.push_back(run("System::Stat",iterations,[](){
+			System::Stat stat;
+		}));
+
+		results.push_back(run("System::Stats::refresh",iterations,[](){
+			static System::Stats stats;
+			stats.refresh();
+		}));
+
+		results.push_back(run("System::Sampler::get",iterations,[](){
+			System::Sampler::getInstance().get(0);
+		}));
+
+		results.push_back(run("Storage::Stat::get",iterations,[](){
+			Storage::Stat::get();
+		}));
+
+		// Physical disks, as used by the storage action; the controller timer runs
+		// refresh(): one /proc/diskstats read dispatched by major:minor.
+		auto &controller = Storage::Controller::getInstance();
+		for(const auto &unit : Storage::Stat::get()) {
+			if(unit.physical()) {
+				controller.push_back(unit);
+			}
+		}
+
+		results.push_back(run("Storage::Controller::refresh",iterations,[&controller](){
+			controller.refresh();
+		}));
+
+		// The agents refresh() from a cached sampler snapshot, take a fresh one on every iteration.
+		{
+			struct Agent : public System::MemoryUsage {
+				using System::MemoryUsage::update;
+			} agent;
+			results.push_back(run("MemoryUsage::update",iterations,[&agent](){
+				agent.update(System::Sampler::getInstance().get(0));
+			}));
+		}
+
+		{
+			struct Agent : public System::LoadAverage {
+				using System::LoadAverage::update;
+			} agent;
+			results.push_back(run("LoadAverage::update",iterations,[&agent](){
+				agent.update(System::Sampler::getInstance().get(0));
+			}));
+		}
+
+		{
+			auto &table = System::ProcessTable::getInstance();
+			std::vector<System::ProcessTable::Process> top;
+			results.push_back(run("ProcessTable::refresh",iterations,[&table,&top](){
+				table.refresh();
+				table.top(System::ProcessTable::CPU,10,top);
+			}));
+		}
+
+		// Storage::Action::call() requires a request and a response; build its rows
+		// from the published snapshot.
+		results.push_back(run("Storage::Action rows",iterations,[&controller](){
+
+			auto snapshot = controller.snapshot();
+			if(!snapshot) {
+				return;
+			}
+
+			Value value;
+			for(const auto &data : *snapshot) {
+				value.clear();
+				data.row(value,Storage::Megabyte);
+			}
+
+		}));
+
+	} catch(const std::exception &e) {
+
+		fprintf(stderr,"%s\n",e.what());
+		return -1;
+
+	}
+
+	if(json) {
+
+		printf("{\n\t\"version\": \"%s\",\n\t\"iterations\": %lu,\n\t\"results\": [\n",PACKAGE_VERSION,iterations);
+		for(size_t ix = 0; ix < results.size(); ix++) {
+			const auto &result = results[ix];
+			printf(
+				"\t\t{ \"name\": \"%s\", \"ns\": %.1f, \"allocations\": %.2f, \"rwcalls\": %.2f }%s\n",
+				result.name,result.ns,result.allocations,result.rwcalls,
+				(ix+1 < results.size() ? "," : "")
+			);
+		}
+		printf("\t]\n}\n");
+
+	} else {
+
+		printf("%-28s %12s %12s %12s\n","Case","ns/op","allocs/op","rw calls/op");
+		for(const auto &result : results) {
+			printf("%-28s %12.1f %12.2f %12.2f\n",result.name,result.ns,result.allocations,result.rwcalls);
+		}
+
+	}
+
+	return 0;
+
+ }
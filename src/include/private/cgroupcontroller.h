@@ -0,0 +1,163 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/timer.h>
+ #include <private/controller.h>
+ #include <private/source.h>
+ #include <string>
+ #include <vector>
+ #include <memory>
+ #include <atomic>
+
+ namespace Udjat {
+
+	namespace CGroup {
+
+		/// @brief Resource usage of a cgroup (v2).
+		/// @details The rates are computed from the last two samples.
+		class Data {
+		public:
+
+			std::string path;					///< @brief The cgroup path, relative to the cgroup root.
+			std::string error;					///< @brief Non empty if update failed.
+
+			struct {
+				float usage = 0;				///< @brief CPU time used, in cpus (1.0 = one cpu busy).
+				float user = 0;					///< @brief User CPU time, in cpus.
+				float system = 0;				///< @brief System CPU time, in cpus.
+				float throttled = 0;			///< @brief Fraction of the time throttled by cpu.max.
+				float quota = 0;				///< @brief CPU limit from cpu.max, in cpus (0 if unlimited).
+			} cpu;
+
+			struct {
+				unsigned long long current = 0;	///< @brief Memory in use (memory.current), in bytes.
+				unsigned long long max = 0;		///< @brief Memory limit (memory.max), in bytes (0 if unlimited).
+				unsigned long long anon = 0;	///< @brief Anonymous memory, in bytes.
+				unsigned long long file = 0;	///< @brief Page cache, in bytes.
+				unsigned long long kernel = 0;	///< @brief Kernel memory, in bytes.
+				unsigned long long sock = 0;	///< @brief Network buffers, in bytes.
+				unsigned long long shmem = 0;	///< @brief Shared memory, in bytes.
+				float pgfault = 0;				///< @brief Page faults per second.
+				float pgmajfault = 0;			///< @brief Major page faults per second.
+			} memory;
+
+			struct {
+				float read = 0;					///< @brief Bytes read per second.
+				float write = 0;				///< @brief Bytes written per second.
+				float rios = 0;					///< @brief Read operations per second.
+				float wios = 0;					///< @brief Write operations per second.
+			} io;
+
+			unsigned long long pids = 0;		///< @brief Number of tasks (pids.current).
+
+			/// @brief Raw counters from the last sample.
+			struct {
+				unsigned long long timestamp = 0;	///< @brief Sample time (System::Root::now()).
+				unsigned long long usage = 0;		///< @brief usage_usec from cpu.stat.
+				unsigned long long user = 0;		///< @brief user_usec from cpu.stat.
+				unsigned long long system = 0;		///< @brief system_usec from cpu.stat.
+				unsigned long long throttled = 0;	///< @brief throttled_usec from cpu.stat.
+				unsigned long long pgfault = 0;		///< @brief pgfault from memory.stat.
+				unsigned long long pgmajfault = 0;	///< @brief pgmajfault from memory.stat.
+				unsigned long long io[4] = {0,0,0,0};	///< @brief rbytes, wbytes, rios and wios from io.stat.
+			} last;
+
+			/// @brief Persistent handles for the cgroup files, null if the controller is not enabled.
+			struct {
+				std::shared_ptr<System::Source> cpu;		///< @brief cpu.stat
+				std::shared_ptr<System::Source> memory;		///< @brief memory.current
+				std::shared_ptr<System::Source> memstat;	///< @brief memory.stat
+				std::shared_ptr<System::Source> io;			///< @brief io.stat
+				std::shared_ptr<System::Source> pids;		///< @brief pids.current
+			} sources;
+
+			Data(const char *path);
+
+			inline bool operator==(const char *p) const {
+				return path == p;
+			}
+
+			/// @brief Get the cgroup file path, relative to System::Root.
+			std::string filename(const char *name) const;
+
+			/// @brief Read the cgroup counters, update rates.
+			void refresh();
+
+			/// @brief Read the cgroup limits (cpu.max, memory.max).
+			void limits();
+
+		};
+
+		/// @brief Watch cgroups, update all of them with a single timer.
+		class UDJAT_PRIVATE Controller : public System::Controller<Data> {
+		private:
+
+			/// @brief Watched path.
+			struct Watch {
+				std::string path;		///< @brief The cgroup path.
+				bool children;			///< @brief Watch the children instead of the cgroup itself.
+			};
+
+			/// @brief The watched paths.
+			std::vector<Watch> watches;
+
+			/// @brief Interval of the children rescan (in milliseconds), 0 to disable.
+			unsigned long long rescan_interval = 60000;
+
+			/// @brief Time of the last rescan (System::Root::now()).
+			unsigned long long rescanned = 0;
+
+			Controller() = default;
+
+		protected:
+
+			/// @brief Update cgroups.
+			void on_timer() override;
+
+		public:
+			static Controller & getInstance();
+
+			/// @brief Get the normalized cgroup path (no leading or trailing slashes).
+			static std::string PathFactory(const char *path);
+
+			/// @brief Setup from XML node.
+			void setup(const XML::Node &node);
+
+			/// @brief Watch a cgroup or its children.
+			/// @param path The cgroup path, relative to the cgroup root.
+			/// @param children If true watch the children of path, the list is refreshed on every rescan.
+			void watch(const char *path, bool children = false);
+
+			/// @brief Insert cgroup into controller, visible on the next published snapshot.
+			/// @return true if the cgroup was inserted, false if it was already present.
+			bool push_back(const char *path);
+
+			/// @brief Rescan the watched paths for new cgroups, reload the limits.
+			/// @details The snapshot is not published, the caller publishes once after the rescan.
+			void rescan();
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/timer.h>
+ #include <vector>
+ #include <memory>
+ #include <atomic>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Update timer of the storage, network and cgroup controllers.
+		class UDJAT_PRIVATE Updater : protected MainLoop::Timer {
+		protected:
+
+			/// @brief Set the timer interval from node, keeping the shortest one.
+			/// @param node The agent or action node ('update-timer' attribute).
+			/// @param domain The log domain.
+			/// @param fallback The interval (in milliseconds) if the timer was not set.
+			void setup(const XML::Node &node, const char *domain, unsigned long fallback);
+
+			/// @brief Enable the timer.
+			/// @param domain The log domain.
+			void autoupdate(const char *domain);
+
+		};
+
+		/// @brief Timer driven list, published as immutable snapshots.
+		/// @details The items are updated on the main loop; the readers get the last
+		/// published snapshot, without copy or lock.
+		template <typename T>
+		class UDJAT_PRIVATE Controller : protected std::vector<T>, protected Updater {
+		public:
+
+			/// @brief Immutable copy of the list, published after every update.
+			typedef std::vector<T> Snapshot;
+
+		private:
+
+			/// @brief The published snapshot, read and replaced with atomic operations.
+			std::shared_ptr<const Snapshot> current;
+
+			/// @brief The previous snapshot, reused as the next one if no reader holds it.
+			std::shared_ptr<Snapshot> spare;
+
+		protected:
+
+			/// @brief Publish a new snapshot.
+			void publish() {
+
+				// Reuse the spare buffer if no reader is holding it; the copy assignment
+				// reuses the existing strings, the timer will not allocate on steady state.
+				std::shared_ptr<Snapshot> next;
+				if(spare && spare.use_count() == 1) {
+					next = std::move(spare);
+				} else {
+					next = std::make_shared<Snapshot>();
+				}
+
+				next->assign(std::vector<T>::begin(),std::vector<T>::end());
+
+				std::shared_ptr<const Snapshot> previous = std::atomic_exchange(&current,std::shared_ptr<const Snapshot>{next});
+				spare = std::const_pointer_cast<Snapshot>(previous);
+
+			}
+
+			/// @brief Was a snapshot published?
+			inline bool published() const {
+				return (bool) std::atomic_load(&current);
+			}
+
+		public:
+
+			/// @brief Get the last published snapshot.
+			/// @details Safe to call from any thread, no copy or lock is made.
+			inline std::shared_ptr<const Snapshot> snapshot() const {
+				return std::atomic_load(&current);
+			}
+
+		};
+
+	}
+
+ }
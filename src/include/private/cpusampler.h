@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/cpuset.h>
+ #include <udjat/tools/timer.h>
+ #include <functional>
+ #include <mutex>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Shared /proc/stat sampler.
+		/// @details Reads /proc/stat once per tick and notifies every subscriber, the tick
+		/// interval is the smallest one requested.
+		class UDJAT_PRIVATE CpuSampler : private MainLoop::Timer {
+		private:
+
+			struct Subscriber {
+				const void *id;
+				unsigned long interval;
+				std::function<void()> callback;
+			};
+
+			mutable std::mutex guard;
+
+			std::vector<Subscriber> subscribers;
+
+			/// @brief The current sample.
+			Stats current;
+
+			/// @brief The previous aggregate row.
+			Stat previous;
+
+			/// @brief The previous per-cpu rows.
+			std::vector<Stat> cpus;
+
+			/// @brief Per-cpu snapshots for the delta kernel.
+			CpuSet sets[2];
+
+			/// @brief Index of the newest entry in 'sets'.
+			unsigned short newest = 0;
+
+			/// @brief Per-cpu fractions from the last two samples.
+			CpuSet::Usage cores;
+
+			/// @brief Aggregate fractions from the last two samples.
+			float values[Stat::TOTAL];
+
+			/// @brief Number of samples taken.
+			unsigned long samples = 0;
+
+			CpuSampler();
+
+			/// @brief Reset timer to the smallest subscriber interval.
+			void reset();
+
+			/// @brief Read /proc/stat, compute fractions.
+			void sample();
+
+		protected:
+
+			void on_timer() override;
+
+		public:
+
+			static CpuSampler & getInstance();
+
+			/// @brief Subscribe for samples.
+			/// @param id The subscriber id.
+			/// @param interval The required interval (in milliseconds).
+			/// @param callback Method called after every sample (optional).
+			void push_back(const void *id, unsigned long interval, const std::function<void()> &callback = std::function<void()>{});
+
+			/// @brief Remove subscriber.
+			void remove(const void *id);
+
+			/// @brief Get fraction of cpu time from the last two samples.
+			/// @param type The field type (TOTAL for non idle time).
+			/// @param cpu The cpu number, -1 for the aggregate value, -2 for the busiest cpu.
+			float get(Stat::Type type, int cpu = -1) const;
+
+			/// @brief Get per-cpu fractions from the last two samples.
+			/// @param callback Called with the per-cpu fractions while the sampler is locked.
+			void get(const std::function<void(const CpuSet::Usage &)> &callback) const;
+
+		};
+
+	}
+
+ }
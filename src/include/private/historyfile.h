@@ -0,0 +1,125 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/history.h>
+ #include <udjat/tools/timer.h>
+ #include <udjat/tools/xml.h>
+ #include <cstdint>
+ #include <mutex>
+ #include <string>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Memory mapped file keeping the history rings between restarts.
+		/// @details Fixed layout: a header, a directory of named entries and the ring segments
+		/// (System::History::Segment followed by the samples). The file is versioned and keyed by
+		/// the kernel boot id; after a reboot the samples are kept but the saved counters are
+		/// marked as invalid. Updates are plain stores, flushed by a periodic msync().
+		class UDJAT_PRIVATE HistoryFile : private MainLoop::Timer {
+		public:
+
+			static constexpr uint32_t version = 1;
+
+			struct Header {
+				char magic[8];				///< @brief File signature.
+				uint32_t version;			///< @brief Layout version.
+				uint32_t entries;			///< @brief Number of used directory entries.
+				uint32_t capacity;			///< @brief Number of directory entries.
+				uint32_t reserved;
+				uint64_t size;				///< @brief File size.
+				uint64_t used;				///< @brief Offset of the first free byte.
+				char boot_id[40];			///< @brief Kernel boot id of the last open.
+			};
+
+			struct Entry {
+				char name[112];				///< @brief History name.
+				uint64_t offset;			///< @brief Segment offset.
+				uint32_t depth;				///< @brief Segment depth.
+				uint32_t reserved;
+			};
+
+		private:
+
+			std::mutex guard;
+
+			/// @brief The file path, empty if not open.
+			std::string filename;
+
+			int fd = -1;
+
+			/// @brief The mapped file.
+			uint8_t *map = nullptr;
+
+			HistoryFile() = default;
+
+			inline Header & header() noexcept {
+				return *((Header *) map);
+			}
+
+			inline Entry * directory() noexcept {
+				return (Entry *) (map + sizeof(Header));
+			}
+
+			/// @brief Format an empty file.
+			void format(size_t size, uint32_t capacity, const char *boot_id) noexcept;
+
+		protected:
+
+			void on_timer() override;
+
+		public:
+
+			~HistoryFile();
+
+			static HistoryFile & getInstance();
+
+			/// @brief Open the history file.
+			/// @param path The history file path.
+			/// @param size The file size (fixed, the segments are allocated from it).
+			/// @param capacity Number of directory entries.
+			/// @param interval The msync() interval in milliseconds.
+			void open(const char *path, size_t size = 16777216, uint32_t capacity = 1024, unsigned long interval = 60000);
+
+			/// @brief Open from the 'state-dir' attribute or the UDJAT_STATE_DIR environment variable.
+			/// @return true if the file is open.
+			bool open(const XML::Node &node);
+
+			inline bool is_open() const noexcept {
+				return map != nullptr;
+			}
+
+			/// @brief Get ring segment, allocate if necessary.
+			/// @param name The history name.
+			/// @param depth The number of samples.
+			/// @return The segment or nullptr if the file is not open or full.
+			History::Segment * get(const char *name, size_t depth);
+
+			/// @brief Flush changes to disk.
+			void sync() noexcept;
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <initializer_list>
+ #include <string>
+ #include <vector>
+ #include <cstdint>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Parser for "key value" files (/proc/meminfo, /proc/vmstat, memory.stat, ...).
+		/// @details The required keys are registered up front and compiled to a collision
+		/// free hash table; the text is parsed in a single pass, without allocation, and
+		/// the values are stored in the order of registration. A 'kB' or 'MB' suffix
+		/// scales the value to bytes.
+		class UDJAT_PRIVATE KeyedParser {
+		private:
+
+			struct Key {
+				std::string name;
+				uint32_t hash;
+			};
+
+			/// @brief The registered keys.
+			std::vector<Key> keys;
+
+			/// @brief Hash table, index of the key or -1 for empty slots.
+			std::vector<int16_t> table;
+
+			/// @brief Hash seed, chosen to avoid collisions.
+			uint32_t seed = 0;
+
+			/// @brief Hash mask (table size - 1).
+			uint32_t mask = 0;
+
+			static uint32_t hash(uint32_t seed, const char *str, size_t length) noexcept;
+
+			/// @brief Build the hash table.
+			void compile();
+
+		public:
+
+			KeyedParser() = default;
+
+			/// @brief Register the keys, a duplicated key throws EINVAL.
+			KeyedParser(std::initializer_list<const char *> keys);
+
+			/// @brief Register a key.
+			/// @return The index of the key value.
+			size_t push_back(const char *key);
+
+			/// @brief Get the number of keys.
+			inline size_t size() const noexcept {
+				return keys.size();
+			}
+
+			/// @brief Get the key name.
+			inline const char * operator[](size_t index) const noexcept {
+				return keys[index].name.c_str();
+			}
+
+			/// @brief Parse text.
+			/// @param text The nul terminated text.
+			/// @param values Array with size() elements; keys not found in the text are set to zero.
+			/// @return The number of keys found.
+			size_t parse(const char *text, unsigned long long *values) const noexcept;
+
+			/// @brief Parse text.
+			/// @param text The nul terminated text.
+			/// @param values Vector of values, resized to size() if necessary.
+			/// @return The number of keys found.
+			size_t parse(const char *text, std::vector<unsigned long long> &values) const;
+
+		};
+
+	}
+
+ }
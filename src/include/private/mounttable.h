@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <private/source.h>
+ #include <mutex>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Cached mount table.
+		/// @details Parsed from /proc/self/mountinfo, the file is kept open and parsed again only
+		/// when poll() reports a change on the mount namespace.
+		class UDJAT_PRIVATE MountTable {
+		public:
+
+			struct Entry {
+				unsigned int major = 0;		///< @brief Device major number.
+				unsigned int minor = 0;		///< @brief Device minor number.
+				std::string mountpoint;		///< @brief Mount point.
+				std::string fstype;			///< @brief Filesystem type.
+				std::string device;			///< @brief Mount source (ex: /dev/sda1).
+			};
+
+		private:
+
+			mutable std::mutex guard;
+
+			/// @brief Persistent handle for /proc/self/mountinfo.
+			Source mountinfo{"/proc/self/mountinfo",16384};
+
+			/// @brief The parsed entries.
+			std::vector<Entry> entries;
+
+			/// @brief Has the table been loaded?
+			bool loaded = false;
+
+			/// @brief System::Root generation of the loaded table.
+			unsigned int generation = 0;
+
+			MountTable() = default;
+
+			/// @brief Parse the mount table if it has changed or if the root has changed.
+			void refresh();
+
+		public:
+
+			static MountTable & getInstance();
+
+			/// @brief Find mounted filesystem.
+			/// @param name The mount point, the device path (/dev/sda1) or the device name (sda1).
+			/// @param entry Receives the mount table entry.
+			/// @return false if not mounted.
+			bool find(const char *name, Entry &entry);
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/timer.h>
+ #include <private/controller.h>
+ #include <private/source.h>
+ #include <string>
+ #include <vector>
+ #include <memory>
+ #include <atomic>
+ #include <unordered_map>
+
+ namespace Udjat {
+
+	namespace Network {
+
+		/// @brief Convenience data for network interface throughput computation.
+		class Data {
+		public:
+
+			/// @brief Counters from /proc/net/dev.
+			enum Counter : unsigned char {
+				Bytes,
+				Packets,
+				Errors,
+				Drops
+			};
+
+			std::string name;					///< @brief The interface name.
+			std::string error;					///< @brief Non empty if update failed.
+
+			unsigned long long speed = 0;		///< @brief Link speed in bits/second (0 if unknown).
+
+			/// @brief Receive rates (per second).
+			struct {
+				float bytes = 0;
+				float packets = 0;
+				float errors = 0;
+				float drops = 0;
+			} rx;
+
+			/// @brief Transmit rates (per second).
+			struct {
+				float bytes = 0;
+				float packets = 0;
+				float errors = 0;
+				float drops = 0;
+			} tx;
+
+			/// @brief Link utilization, the busiest direction against the link speed.
+			float utilization = 0;
+
+			/// @brief Raw counters from the last sample.
+			struct {
+				unsigned long long timestamp = 0;			///< @brief Sample time (System::Root::now()).
+				unsigned long long rx[4] = {0,0,0,0};		///< @brief Bytes, packets, errors and drops received.
+				unsigned long long tx[4] = {0,0,0,0};		///< @brief Bytes, packets, errors and drops transmitted.
+			} last;
+
+			Data(const char *name, size_t length);
+
+			inline bool operator==(const char *n) const {
+				return name == n;
+			}
+
+			/// @brief Read link speed from /sys/class/net/[interface]/speed.
+			void link();
+
+			/// @brief Update rates.
+			/// @param now The sample time (System::Root::now()).
+			/// @param rx The bytes, packets, errors and drops received.
+			/// @param tx The bytes, packets, errors and drops transmitted.
+			void update(unsigned long long now, const unsigned long long *rx, const unsigned long long *tx);
+
+		};
+
+		/// @brief Watch network interfaces, update all of them from a single /proc/net/dev read.
+		class UDJAT_PRIVATE Controller : public System::Controller<Data> {
+		private:
+
+			/// @brief Persistent handle for /proc/net/dev.
+			System::Source netdev{"/proc/net/dev",4096};
+
+			/// @brief Index of interfaces by name.
+			std::unordered_map<std::string,size_t> index;
+
+			/// @brief Interfaces found on the last /proc/net/dev read.
+			std::vector<bool> found;
+
+			/// @brief Watch the loopback interface.
+			bool loopback = false;
+
+			/// @brief Interval of the link speed reload (in milliseconds), 0 to disable.
+			unsigned long long link_interval = 60000;
+
+			/// @brief Time of the last link speed reload (System::Root::now()).
+			unsigned long long linked = 0;
+
+			/// @brief Rebuild the name index.
+			void reindex();
+
+			Controller() = default;
+
+		protected:
+
+			/// @brief Update interface rates.
+			void on_timer() override;
+
+		public:
+			static Controller & getInstance();
+
+			/// @brief Setup from XML node.
+			void setup(const XML::Node &node);
+
+			/// @brief Read /proc/net/dev, update interfaces.
+			void refresh();
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <vector>
+ #include <memory>
+ #include <mutex>
+ #include <condition_variable>
+ #include <thread>
+ #include <cstdint>
+ #include <sys/types.h>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Process table from /proc/[pid]/stat.
+		/// @details The pid list is read with getdents64() from a cached /proc descriptor and split
+		/// across a small worker pool; the counters from the previous scan are kept in an open
+		/// addressing hash, keyed by pid, for the rate computation.
+		class UDJAT_PRIVATE ProcessTable {
+		public:
+
+			/// @brief Sort key.
+			enum Key : unsigned char {
+				CPU,			///< @brief CPU usage.
+				RSS,			///< @brief Resident set size.
+				Faults,			///< @brief Page faults per second.
+				Threads			///< @brief Number of threads.
+			};
+
+			/// @brief Get sort key from name.
+			static Key KeyFactory(const char *name);
+
+			struct Process {
+				pid_t pid = 0;						///< @brief The process id.
+				char name[16];						///< @brief The command name (comm).
+				float cpu = 0;						///< @brief CPU usage, in cpus (1.0 = one cpu busy).
+				unsigned long long rss = 0;			///< @brief Resident set size in bytes.
+				float faults = 0;					///< @brief Page faults (minor and major) per second.
+				float majflt = 0;					///< @brief Major page faults per second.
+				unsigned int threads = 0;			///< @brief Number of threads.
+
+				unsigned long long start = 0;		///< @brief Start time (clock ticks after boot), detects pid reuse.
+				unsigned long long ticks = 0;		///< @brief User and system time (clock ticks).
+				unsigned long long minflt = 0;		///< @brief Minor faults.
+				unsigned long long majflts = 0;		///< @brief Major faults.
+			};
+
+		private:
+
+			class Worker;
+
+			mutable std::mutex guard;
+
+			/// @brief The cached /proc descriptor.
+			int procfd = -1;
+
+			/// @brief System::Root generation of procfd.
+			unsigned int generation = 0;
+
+			/// @brief Buffer for getdents64().
+			std::vector<char> dents;
+
+			/// @brief The pids from the last scan.
+			std::vector<pid_t> pids;
+
+			/// @brief The processes from the last scan.
+			std::vector<Process> processes;
+
+			/// @brief The processes from the current scan, swapped with 'processes' when complete.
+			std::vector<Process> loaded;
+
+			/// @brief Hash slot for the previous scan.
+			struct Slot {
+				pid_t pid = 0;				///< @brief The process id, 0 for empty slots.
+				uint32_t index = 0;			///< @brief Index in 'processes'.
+			};
+
+			/// @brief Open addressing hash of 'processes', by pid.
+			std::vector<Slot> table;
+
+			/// @brief Time of the last scan (System::Root::now()).
+			unsigned long long timestamp = 0;
+
+			/// @brief The worker pool.
+			std::vector<std::unique_ptr<Worker>> workers;
+
+			/// @brief Sort buffer for top().
+			mutable std::vector<uint32_t> order;
+
+			ProcessTable();
+
+			/// @brief Get the cached /proc descriptor, reopen it if the System::Root has changed.
+			int descriptor();
+
+			/// @brief Read the pid list.
+			void list();
+
+			/// @brief Rebuild the hash table.
+			void reindex();
+
+			/// @brief Find a process from the previous scan.
+			const Process * find(pid_t pid) const noexcept;
+
+			/// @brief Load processes from /proc/[pid]/stat.
+			/// @param from First pid index.
+			/// @param to Last pid index (not included).
+			/// @param seconds Time since the last scan.
+			/// @param result Vector for the loaded processes.
+			void load(size_t from, size_t to, double seconds, std::vector<Process> &result) const noexcept;
+
+		public:
+
+			static ProcessTable & getInstance();
+
+			~ProcessTable();
+
+			/// @brief Scan the process table.
+			/// @param max_age Maximum age (in milliseconds) of the last scan; a new one is
+			/// done if the last one is older.
+			void refresh(unsigned long max_age = 0);
+
+			/// @brief Get the number of processes from the last scan.
+			size_t size() const;
+
+			/// @brief Get the top processes from the last scan.
+			/// @param key The sort key.
+			/// @param count The number of processes.
+			/// @param result Receives the top processes, in descending order.
+			void top(Key key, size_t count, std::vector<Process> &result) const;
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Locale-free helpers for scanning procfs/sysfs text in place.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <cstring>
+
+ namespace Udjat {
+
+	namespace Scanner {
+
+		/// @brief Skip blanks (but not line breaks).
+		inline const char * blanks(const char *ptr) noexcept {
+			while(*ptr == ' ' || *ptr == '\t') {
+				ptr++;
+			}
+			return ptr;
+		}
+
+		/// @brief Skip the current word.
+		inline const char * word(const char *ptr) noexcept {
+			while(*ptr && *ptr != ' ' && *ptr != '\t' && *ptr != '\n') {
+				ptr++;
+			}
+			return ptr;
+		}
+
+		/// @brief Get the beginning of the next line (or the end of the buffer).
+		inline const char * eol(const char *ptr) noexcept {
+			while(*ptr && *ptr != '\n') {
+				ptr++;
+			}
+			return *ptr ? ptr+1 : ptr;
+		}
+
+		/// @brief Check if the current word is exactly 'key'.
+		inline bool is(const char *ptr, const char *key, size_t length) noexcept {
+			return strncmp(ptr,key,length) == 0 && (ptr[length] == ' ' || ptr[length] == '\t' || ptr[length] == ':');
+		}
+
+		/// @brief Parse an unsigned decimal number, advancing the pointer.
+		/// @param ptr The text position, updated to the first character after the number.
+		/// @param value Receives the parsed value.
+		/// @return false if there's no number at the current position.
+		inline bool number(const char * &ptr, unsigned long long &value) noexcept {
+
+			ptr = blanks(ptr);
+
+			if(*ptr < '0' || *ptr > '9') {
+				return false;
+			}
+
+			unsigned long long rc = 0;
+			while(*ptr >= '0' && *ptr <= '9') {
+				rc = (rc * 10) + (*ptr - '0');
+				ptr++;
+			}
+
+			value = rc;
+			return true;
+
+		}
+
+		/// @brief Parse an unsigned decimal fraction (ex: '0.52'), advancing the pointer.
+		inline bool decimal(const char * &ptr, double &value) noexcept {
+
+			unsigned long long integer;
+			if(!number(ptr,integer)) {
+				return false;
+			}
+
+			double rc = (double) integer;
+			if(*ptr == '.') {
+				double scale = 0.1;
+				for(ptr++; *ptr >= '0' && *ptr <= '9'; ptr++) {
+					rc += (*ptr - '0') * scale;
+					scale /= 10;
+				}
+			}
+
+			value = rc;
+			return true;
+
+		}
+
+		template <typename T>
+		inline bool number(const char * &ptr, T &value) noexcept {
+			unsigned long long v;
+			if(!number(ptr,v)) {
+				return false;
+			}
+			value = (T) v;
+			return true;
+		}
+
+	}
+
+ }
@@ -0,0 +1,93 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Persistent descriptor for a procfs/sysfs file.
+		/// @details Keeps the file open between samples and re-reads it with pread() from
+		/// offset zero into a preallocated buffer; the file is reopened if the descriptor
+		/// becomes stale (ENODEV/ESTALE) or when the System::Root changes.
+		class UDJAT_PRIVATE Source {
+		private:
+
+			/// @brief The file path, relative to System::Root.
+			std::string path;
+
+			/// @brief The file descriptor, -1 if not open.
+			int fd = -1;
+
+			/// @brief System::Root generation of the open descriptor.
+			unsigned int generation = 0;
+
+			/// @brief The read buffer.
+			std::vector<char> buffer;
+
+			/// @brief Length of the last read.
+			size_t length = 0;
+
+			void open();
+			void close() noexcept;
+
+		public:
+
+			/// @brief Build source.
+			/// @param path The file path.
+			/// @param size The initial buffer size (it will grow if the file is larger).
+			Source(const char *path, size_t size = 4096);
+
+			Source(const Source &) = delete;
+			Source & operator=(const Source &) = delete;
+
+			~Source();
+
+			inline const char * name() const noexcept {
+				return path.c_str();
+			}
+
+			/// @brief Get the file descriptor, opening the file if necessary.
+			int descriptor();
+
+			/// @brief Read the file contents.
+			/// @return Pointer to the nul terminated contents, valid until the next read.
+			const char * read();
+
+			/// @brief Read the beginning of the file into a caller supplied buffer.
+			/// @param buffer The buffer.
+			/// @param length The buffer length (the contents will be nul terminated).
+			/// @return The number of bytes read.
+			size_t read(char *buffer, size_t length);
+
+			/// @brief Get the length of the last read.
+			inline size_t size() const noexcept {
+				return length;
+			}
+
+		};
+
+	}
+
+ }
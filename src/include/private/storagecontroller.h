@@ -21,12 +21,20 @@
 
  #include <udjat/defs.h>
  #include <udjat/tools/storage/stat.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <udjat/tools/value.h>
  #include <pugixml.hpp>
  #include <string>
  #include <vector>
  #include <udjat/tools/string.h>
  #include <udjat/tools/container.h>
  #include <udjat/tools/timer.h>
+ #include <private/controller.h>
+ #include <private/source.h>
+ #include <udjat/tools/system/history.h>
+ #include <memory>
+ #include <atomic>
+ #include <unordered_map>
 
  namespace Udjat {
 
@@ -38,7 +46,9 @@
 
 			std::string error;					///< @brief Non empty if update failed.
 
-			float blocksize;					///< @brief The disk block size in bytes.
+			unsigned int major = 0;				///< @brief The major number of the disk.
+			unsigned int minor = 0;				///< @brief The minor number of the disk (up to 20 bits).
+
 			float read = 0;						///< @brief The read speed in bytes/second.
 			float write = 0;					///< @brief The write speed in bytes/second.
 
@@ -57,27 +67,115 @@
 
 			} saved;
 
-			Data(const Storage::Stat &stat) : Stat::Device{stat.device}, blocksize{(float) stat.blocksize()} {
+			/// @brief Extended statistics (iostat -x), from the last two samples.
+			struct {
+				float rps = 0;					///< @brief Read requests completed per second (r/s).
+				float wps = 0;					///< @brief Write requests completed per second (w/s).
+				float rareq = 0;				///< @brief Average size of the read requests in bytes (rareq-sz).
+				float wareq = 0;				///< @brief Average size of the write requests in bytes (wareq-sz).
+				float r_await = 0;				///< @brief Average time for read requests in milliseconds (r_await).
+				float w_await = 0;				///< @brief Average time for write requests in milliseconds (w_await).
+				float aqu = 0;					///< @brief Average queue length (aqu-sz).
+				float util = 0;					///< @brief Fraction of time with I/O in progress (%util).
+				float rrqm = 0;					///< @brief Fraction of read requests merged (%rrqm).
+				float wrqm = 0;					///< @brief Fraction of write requests merged (%wrqm).
+				float discard = 0;				///< @brief Discarded bytes per second.
+			} iostat;
+
+			/// @brief Raw counters from the last sample, for the extended statistics.
+			struct {
+				unsigned long long timestamp = 0;	///< @brief Sample time (System::Root::now()).
+				unsigned long count[3] = {0,0,0};	///< @brief Completed requests (read, write, discard).
+				unsigned long merged[3] = {0,0,0};	///< @brief Merged requests (read, write, discard).
+				unsigned long sectors[3] = {0,0,0};	///< @brief Sectors (read, write, discard).
+				unsigned long time[3] = {0,0,0};	///< @brief Milliseconds spent (read, write, discard).
+				unsigned int io = 0;				///< @brief Milliseconds spent doing I/O.
+				unsigned int weighted = 0;			///< @brief Weighted milliseconds spent doing I/O.
+			} last;
+
+			/// @brief Persistent handle for /sys/block/[device]/stat.
+			std::shared_ptr<System::Source> source;
+
+			/// @brief Read/write speed history, shared with the published snapshots.
+			struct {
+				std::shared_ptr<System::History> read;
+				std::shared_ptr<System::History> write;
+			} history;
+
+			Data(const Storage::Stat &stat, size_t depth = 0)
+				: Stat::Device{stat.device}, major{stat.major}, minor{stat.minor},
+					source{std::make_shared<System::Source>(String{"/sys/block/",stat.name(),"/stat"}.c_str(),256)} {
+				history.read = std::make_shared<System::History>(depth);
+				history.write = std::make_shared<System::History>(depth);
 			}
 
 			inline bool operator==(const Stat &stat) const {
 				return *this == stat.device;
 			}	
 
-			/// @brief Update disk speed.
+			/// @brief Fill a storage action report row.
+			void row(Udjat::Value &value, const Storage::Unit unit) const;
+
+			/// @brief Update disk speed from /sys/block/[device]/stat.
 			void refresh();
 
+			/// @brief Update disk speed and extended statistics from already loaded counters.
+			void update(const Storage::Stat &stat);
+
+			/// @brief Update extended statistics.
+			void extend(const Storage::Stat &stat);
+
+			/// @brief Keep history and counters in the persistent history file.
+			void persist();
+
 		};
 
-		class UDJAT_PRIVATE Controller : private std::vector<Data>, private MainLoop::Timer {
+		class UDJAT_PRIVATE Controller : public System::Controller<Data> {
 		private:
-		
+
+			/// @brief Persistent handle for /proc/diskstats.
+			System::Source diskstats{"/proc/diskstats",16384};
+
+			/// @brief Index of disks by major:minor.
+			std::unordered_map<uint32_t,size_t> index;
+
+			/// @brief Disks found on the last /proc/diskstats read.
+			std::vector<bool> found;
+
+			/// @brief History depth for new disks.
+			size_t depth = 0;
+
+			/// @brief History rollup tiers for new disks.
+			std::string rollup;
+
+			/// @brief Block device hotplug monitor.
+			class Monitor;
+			std::shared_ptr<Monitor> monitor;
+
+			/// @brief Interval of the fallback rescan (in milliseconds), 0 to disable.
+			unsigned long long reconcile_interval = 300000;
+
+			/// @brief Time of the last rescan (System::Root::now()).
+			unsigned long long reconciled = 0;
+
+			/// @brief Rebuild the major:minor index.
+			void reindex();
+
+			/// @brief Build the hotplug monitor.
+			std::shared_ptr<Monitor> MonitorFactory();
+
+			static inline uint32_t key(unsigned int major, unsigned int minor) noexcept {
+				return (major << 20) | minor;
+			}
+
 			Controller() = default;
 	
 		protected:
 
 			/// @brief Update disk speed.
-			void on_timer() override;
+			inline void on_timer() override {
+				refresh();
+			}
 
 		public:
 			static Controller & getInstance();
@@ -90,14 +188,16 @@
 			/// @return true if the disk was inserted, false if it was already present.
 			bool push_back(const Storage::Stat &stat);
 
-			auto begin() const {
-				return std::vector<Data>::begin();
-			}
+			/// @brief Remove disk from controller.
+			/// @return true if the disk was removed.
+			bool remove(unsigned int major, unsigned int minor);
+
+			/// @brief Rescan /proc/diskstats for new physical disks.
+			void reconcile();
+
+			/// @brief Read /proc/diskstats, update every disk and publish a new snapshot.
+			void refresh();
 
-			auto end() const {
-				return std::vector<Data>::end();
-			}
-			
 		};
 
 
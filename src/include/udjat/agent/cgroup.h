@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares cgroup (v2) resource usage agents.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/history.h>
+ #include <string>
+ #include <vector>
+ #include <atomic>
+
+ namespace Udjat {
+
+	namespace CGroup {
+
+		class Data;
+
+		/// @brief Resource usage of a cgroup.
+		/// @details The value is the fraction of the cgroup limit in use (cpu.max, memory.max), or
+		/// the fraction of the system resources for unlimited cgroups. All agents share the cgroup
+		/// controller, the agent refresh doesn't read any file.
+		class UDJAT_API Usage : public Agent<Percentage> {
+		public:
+
+			/// @brief The watched resource.
+			enum Resource : unsigned char {
+				CPU,
+				Memory
+			};
+
+		private:
+
+			/// @brief The watched resource.
+			Resource resource;
+
+			/// @brief The cgroup path, relative to the cgroup root.
+			std::string path;
+
+			/// @brief Position of the cgroup in the last snapshot.
+			mutable std::atomic<size_t> hint{0};
+
+			/// @brief Value history.
+			System::History history;
+
+			/// @brief Find cgroup data in the controller snapshot.
+			const Data * find(const std::vector<Data> &snapshot) const;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			private:
+				Resource resource;
+
+			public:
+				Factory(const char *name, Resource r) : Udjat::Abstract::Agent::Factory{name}, resource{r} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			Usage(const XML::Node &node, Resource resource);
+			virtual ~Usage();
+
+			bool refresh() override;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
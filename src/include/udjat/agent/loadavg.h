@@ -25,7 +25,10 @@
  #include <udjat/agent.h>
  #include <udjat/agent/abstract.h>
  #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <udjat/tools/system/history.h>
  #include <cstdlib>
+ #include <memory>
  
  namespace Udjat {
 
@@ -33,11 +36,30 @@
 
 		class UDJAT_API LoadAverage : public Agent<Percentage> {
 		private:
-			size_t cores = 0;
+			float cores = 0;
 			uint8_t type = 0;
 
+			/// @brief Report against the effective cpus (affinity and cgroup cpu.max) instead of the host cpus.
+			bool container = false;
+
+			/// @brief High resolution estimator, samples the runnable tasks at sub-second intervals.
+			/// @details Without an 'update-timer' attribute the value is published every second.
+			class Estimator;
+			std::unique_ptr<Estimator> estimator;
+
+			/// @brief Get the effective number of cores.
+			float effective() const;
+
+			/// @brief Value history.
+			History history;
+
 			void setup(uint8_t minutes = 5);
 
+		protected:
+
+			/// @brief Update value from snapshot.
+			bool update(const Snapshot &snapshot);
+
 		public:
 
 			class Factory : public Abstract::Agent::Factory {
@@ -53,8 +75,11 @@
 			virtual ~LoadAverage();
 
 			void start() override;
+			void stop() override;
 			bool refresh() override;
 
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
 			std::shared_ptr<Abstract::State> computeState() override;
 
 
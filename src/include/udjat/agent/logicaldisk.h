@@ -18,9 +18,14 @@
  */
 
  /// @brief Declares partition monitor.
- 
+
+ #pragma once
+
  #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
  #include <udjat/agent/abstract.h>
+ #include <udjat/tools/string.h>
  #include <udjat/tools/xml.h>
  
  namespace Udjat {
@@ -28,11 +33,23 @@
 	namespace Disk {
 
 		/// @brief Agent watching a logical disk.
-		class UDJAT_API Logical : public Abstract::Agent {
+		/// @details The value is the fraction of the filesystem space in use.
+		class UDJAT_API Logical : public Agent<Percentage> {
 		protected:
 
-			/// @brief Device name.
-			const char *devname;
+			/// @brief Device name or mount point.
+			String devname;
+
+			/// @brief Filesystem usage from the last refresh.
+			struct {
+				std::string mountpoint;				///< @brief The mount point.
+				std::string device;					///< @brief The mounted device.
+				std::string fstype;					///< @brief The filesystem type.
+				unsigned long long total = 0;		///< @brief Filesystem size in bytes.
+				unsigned long long available = 0;	///< @brief Bytes available to unprivileged users.
+				unsigned long long free = 0;		///< @brief Free bytes.
+				float inodes = 0;					///< @brief Fraction of inodes in use.
+			} usage;
 
 		public:
 
@@ -56,6 +73,8 @@
 			/// @brief Get device status, update state.
 			bool refresh() override;
 
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
 			std::shared_ptr<Abstract::State> computeState() override;
 
 		};
@@ -63,4 +82,3 @@
 	}
 
  }
-
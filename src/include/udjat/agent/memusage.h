@@ -24,12 +24,30 @@
  #include <udjat/agent.h>
  #include <udjat/agent/abstract.h>
  #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <udjat/tools/system/history.h>
  
  namespace Udjat {
 
 	namespace System {
 
 		class UDJAT_API MemoryUsage : public Agent<Percentage> {
+		private:
+
+			/// @brief Report against the cgroup memory limit instead of the host memory.
+			bool container = false;
+
+			/// @brief Container mode is reporting the host memory (logged on change).
+			bool fallback = false;
+
+			/// @brief Value history.
+			History history;
+
+		protected:
+
+			/// @brief Update value from snapshot.
+			bool update(const Snapshot &snapshot);
+
 		public:
 
 			class Factory : public Abstract::Agent::Factory {
@@ -47,6 +65,8 @@
 			void start() override;
 			bool refresh() override;
 
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
 			std::shared_ptr<Abstract::State> computeState() override;
 
 
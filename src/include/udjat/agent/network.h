@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares network interface agent.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/history.h>
+ #include <string>
+ #include <vector>
+ #include <atomic>
+
+ namespace Udjat {
+
+	namespace Network {
+
+		class Data;
+
+		/// @brief Network interface throughput.
+		/// @details The value is the link utilization (the busiest direction against the link speed),
+		/// zero for interfaces without speed information. All agents share the network controller,
+		/// the agent refresh doesn't read any file.
+		class UDJAT_API Interface : public Agent<Percentage> {
+		private:
+
+			/// @brief The interface name.
+			std::string ifname;
+
+			/// @brief Position of the interface in the last snapshot.
+			mutable std::atomic<size_t> hint{0};
+
+			/// @brief Value history.
+			System::History history;
+
+			/// @brief Find interface data in the controller snapshot.
+			const Data * find(const std::vector<Data> &snapshot) const;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			public:
+				Factory(const char *name = "NetworkInterface") : Udjat::Abstract::Agent::Factory{name} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			Interface(const XML::Node &node);
+			virtual ~Interface();
+
+			bool refresh() override;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares pressure stall information (PSI) agents.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/history.h>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include <type_traits>
+
+ namespace Udjat {
+
+	namespace System {
+
+		class Source;
+
+		/// @brief Pressure stall information from /proc/pressure/* or from a cgroup *.pressure file.
+		/// @details The value is the selected average ('some' or 'full' line) as a fraction of time. States
+		/// with a 'trigger' attribute ("some 150000 1000000") register a kernel PSI trigger and are
+		/// activated from the main loop when the kernel reports the stall, no periodic sampling is required.
+		class UDJAT_API Pressure : public Agent<Percentage> {
+		public:
+
+			/// @brief The watched resource.
+			enum Resource : unsigned char {
+				CPU,
+				Memory,
+				IO
+			};
+
+			class Trigger;
+
+		private:
+
+			/// @brief The watched resource.
+			Resource resource;
+
+			/// @brief The pressure file, relative to System::Root.
+			std::string filename;
+
+			/// @brief Line for the agent value (0 = some, 1 = full).
+			unsigned char line = 0;
+
+			/// @brief Average for the agent value (0 = avg10, 1 = avg60, 2 = avg300).
+			unsigned char field = 0;
+
+			/// @brief Persistent handle for the pressure file.
+			std::shared_ptr<Source> source;
+
+			/// @brief Values from the last read.
+			struct {
+				float avg[3] = {0,0,0};			///< @brief avg10, avg60 and avg300 (fraction of time).
+				unsigned long long total = 0;	///< @brief Total stall time in microseconds.
+				float rate = 0;					///< @brief Stall time per second between the last two reads (fraction of time).
+			} lines[2];
+
+			/// @brief Time of the last read (System::Root::now()).
+			unsigned long long timestamp = 0;
+
+			/// @brief The state type of Agent<Percentage>.
+			typedef std::decay<decltype(*states.front())>::type BaseState;
+
+			/// @brief State with an optional kernel trigger.
+			class State;
+
+			/// @brief The agent states.
+			std::vector<std::shared_ptr<State>> watches;
+
+			/// @brief Value history.
+			History history;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			private:
+				Resource resource;
+
+			public:
+				Factory(const char *name, Resource r) : Udjat::Abstract::Agent::Factory{name}, resource{r} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			Pressure(const XML::Node &node, Resource resource);
+			virtual ~Pressure();
+
+			bool refresh() override;
+
+			/// @brief Called from the main loop when a kernel trigger fires or expires.
+			void triggered() noexcept;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node) override;
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares top processes agent.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+
+ namespace Udjat {
+
+	namespace Processes {
+
+		/// @brief The busiest process.
+		/// @details The value is the share of the top process, by CPU (against the online cpus) or
+		/// by resident memory (against MemTotal); the top processes are exported as properties.
+		class UDJAT_API Top : public Agent<Percentage> {
+		private:
+
+			/// @brief The sort key (CPU or RSS).
+			unsigned char key;
+
+			/// @brief Number of processes in the properties.
+			size_t count;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			public:
+				Factory(const char *name = "TopProcesses") : Udjat::Abstract::Agent::Factory{name} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			Top(const XML::Node &node);
+			virtual ~Top();
+
+			bool refresh() override;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
@@ -24,12 +24,29 @@
  #include <udjat/agent.h>
  #include <udjat/agent/abstract.h>
  #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <udjat/tools/system/history.h>
+ #include <udjat/tools/system/swaps.h>
+ #include <mutex>
  
  namespace Udjat {
 
 	namespace System {
 
 		class UDJAT_API SwapUsage : public Agent<Percentage> {
+		private:
+
+			/// @brief Value history.
+			History history;
+
+			mutable std::mutex guard;
+
+			/// @brief Swap devices and compressed tiers from the last update.
+			Swaps swaps;
+
+			/// @brief Update value from snapshot.
+			bool update(const Snapshot &snapshot);
+
 		public:
 
 			class Factory : public Abstract::Agent::Factory {
@@ -47,6 +64,8 @@
 			void start() override;
 			bool refresh() override;
 
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
 			std::shared_ptr<Abstract::State> computeState() override;
 
 
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares system stat (cpu usage) agent.
+
+ #pragma once
+ 
+ #include <udjat/defs.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/history.h>
+ #include <vector>
+ #include <memory>
+ #include <type_traits>
+ 
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief CPU usage from /proc/stat.
+		/// @details All agents share a single /proc/stat sampler.
+		class UDJAT_API SysStat : public Agent<Percentage> {
+		private:
+
+			/// @brief Selected field.
+			Stat::Type type = Stat::TOTAL;
+
+			/// @brief Selected cpu (-1 for all cpus, -2 for the busiest one).
+			int cpu = -1;
+
+			/// @brief Value history.
+			History history;
+
+			typedef std::decay<decltype(*states.front())>::type BaseState;
+
+			/// @brief State on a /proc/stat field ('field-name', the agent field by default).
+			class State;
+
+			/// @brief The agent states.
+			std::vector<std::shared_ptr<State>> watches;
+
+			/// @brief Number of states on a field other than the agent one.
+			size_t foreign = 0;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			public:
+				Factory(const char *name = "SysStat") : Udjat::Abstract::Agent::Factory{name} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			SysStat(const XML::Node &node);
+			virtual ~SysStat();
+
+			void start() override;
+			void stop() override;
+			bool refresh() override;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node) override;
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares paging, swapping and reclaim rate agent.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/vmstat.h>
+ #include <udjat/tools/system/history.h>
+ #include <memory>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Rate (per second) of a /proc/vmstat counter.
+		/// @details The states can select their own counter with 'field-name', a state like
+		/// <state field-name='pgmajfault' from='500' ... /> is activated on more than 500 major
+		/// faults per second, whatever the agent counter.
+		class UDJAT_API VmStat : public Agent<float> {
+		private:
+
+			/// @brief Selected counter.
+			VmCounters::Counter counter;
+
+			/// @brief Rates from the last refresh, against this agent's own baseline.
+			VmCounters::Rates rates;
+
+			/// @brief Value history.
+			History history;
+
+			/// @brief State watching its own counter.
+			class State;
+
+			/// @brief The agent states.
+			std::vector<std::shared_ptr<State>> watches;
+
+		public:
+
+			class Factory : public Abstract::Agent::Factory {
+			public:
+				Factory(const char *name = "VmStat") : Udjat::Abstract::Agent::Factory{name} {
+				}
+
+				std::shared_ptr<Abstract::Agent> AgentFactory(const XML::Node &node) const override;
+			};
+
+			VmStat(const XML::Node &node);
+			virtual ~VmStat();
+
+			void start() override;
+			bool refresh() override;
+
+			Udjat::Value & getProperties(Udjat::Value &value) const noexcept override;
+
+			std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node) override;
+			std::shared_ptr<Abstract::State> computeState() override;
+
+		};
+
+	}
+
+ }
@@ -28,7 +28,18 @@
  #include <udjat/agent/swapusage.h>
  #include <udjat/agent/memusage.h>
  #include <udjat/agent/uptime.h>
+ #include <udjat/agent/sysstat.h>
+ #include <udjat/agent/logicaldisk.h>
+ #include <udjat/agent/cgroup.h>
+ #include <udjat/agent/pressure.h>
+ #include <udjat/agent/network.h>
+ #include <udjat/agent/processes.h>
+ #include <udjat/agent/vmstat.h>
  #include <udjat/tools/actions/storage.h>
+ #include <udjat/tools/actions/cgroup.h>
+ #include <udjat/tools/actions/network.h>
+ #include <udjat/tools/actions/processes.h>
+ #include <udjat/tools/actions/vmstat.h>
 
  namespace Udjat {
 
@@ -42,7 +53,21 @@
 			System::SwapUsage::Factory		swapusagefactory;
 			System::MemoryUsage::Factory	memusagefactory;
 			System::UpTime::Factory			uptimefactory;
+			System::SysStat::Factory		sysstatfactory;
+			Disk::Logical::Factory			logicaldiskfactory;
+			System::Pressure::Factory		cpupressurefactory{"CpuPressure",System::Pressure::CPU};
+			System::Pressure::Factory		mempressurefactory{"MemoryPressure",System::Pressure::Memory};
+			System::Pressure::Factory		iopressurefactory{"IoPressure",System::Pressure::IO};
 			Storage::Action::Factory		storagefactory;	
+			CGroup::Usage::Factory			cgroupcpufactory{"CGroupCpuUsage",CGroup::Usage::CPU};
+			CGroup::Usage::Factory			cgroupmemfactory{"CGroupMemoryUsage",CGroup::Usage::Memory};
+			CGroup::Action::Factory			cgroupfactory;
+			Network::Interface::Factory		interfacefactory;
+			Network::Action::Factory		networkfactory;
+			Processes::Top::Factory			topprocessesfactory;
+			Processes::Action::Factory		processesfactory;
+			System::VmStat::Factory			vmstatfactory;
+			VmStat::Action::Factory			vmstatactionfactory;
 
 		public:
 
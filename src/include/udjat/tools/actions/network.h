@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/action.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <udjat/tools/value.h>
+ #include <string>
+
+ namespace Udjat {
+
+	namespace Network {
+
+		class Data;
+
+		/// @brief Report throughput of network interfaces.
+		class UDJAT_API Action : public Udjat::Action {
+		private:
+			Storage::Unit unit;
+
+		protected:
+
+			/// @brief Extend response item with more information about the interface.
+			/// @param data The interface data.
+			/// @param value The value to be extended.
+			virtual void getValues(const Data &data, Udjat::Value &value);
+
+		public:
+
+			class Factory : public Udjat::Action::Factory {
+			public:
+				Factory(const char *name = "network") : Udjat::Action::Factory{name} {
+				}
+
+				std::shared_ptr<Udjat::Action> ActionFactory(const XML::Node &node) const override;
+
+			};
+
+			Action(const XML::Node &node);
+			virtual ~Action();
+
+			int call(Udjat::Request &request, Udjat::Response &response, bool except) override;
+
+		};
+
+	}
+
+ }
@@ -30,10 +30,23 @@
 
 	namespace Storage {
 
+		/// @brief Report the disk statistics, the speed history or the rollup tiers ('report' attribute).
 		class UDJAT_API Action : public Udjat::Action {
+		public:
+
+			/// @brief The report contents.
+			enum Contents : uint8_t {
+				Statistics,		///< @brief Current speed and extended statistics ('stats', the default).
+				History,		///< @brief One row for every read/write sample ('history').
+				Rollup			///< @brief One row for every bucket of every rollup tier ('rollup').
+			};
+
 		private:
 			Unit unit;
 
+			/// @brief The report contents.
+			Contents contents = Statistics;
+
 		protected:
 
 			/// @brief Extend response item with more information about the device.
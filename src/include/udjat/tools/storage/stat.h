@@ -65,8 +65,13 @@
 
 			Device device;
 
-			unsigned short major = 0;			///< @brief The major number of the disk.
-			unsigned short minor = 0;			///< @brief The minor number of the disk.
+			/// @brief Size of the sector unit used by the kernel disk counters.
+			/// @details /proc/diskstats and /sys/block/[device]/stat allways count 512 byte sectors,
+			/// regardless of the device block size.
+			static constexpr size_t sector_size = 512;
+
+			unsigned int major = 0;				///< @brief The major number of the disk.
+			unsigned int minor = 0;				///< @brief The minor number of the disk (up to 20 bits).
 
 			struct {
 				unsigned long count = 0;		///< @brief The total number of reads completed successfully.
@@ -95,6 +100,11 @@
 				unsigned long time = 0;			///< @brief The number of milliseconds spent discarding.
 			} discards;
 
+			struct {
+				unsigned long count = 0;		///< @brief The total number of flush requests completed successfully.
+				unsigned long time = 0;			///< @brief The number of milliseconds spent flushing.
+			} flush;
+
 			/// @brief Build an empty device.
 			Stat() {
 			}
@@ -106,6 +116,11 @@
 			/// @brief Load device stats from system.
 			void load();
 
+			/// @brief Load device counters.
+			/// @param contents The contents of /sys/block/[device]/stat or a /proc/diskstats line after the device name;
+			/// the 11, 15 and 17 (flush aware) fields formats are accepted.
+			void load(const char *contents);
+
 			/// @brief Is a logical disk?
 			inline bool logical() const noexcept {
 				return major != 0 && minor != 0;
@@ -117,9 +132,15 @@
 			/// @brief Load /proc/diskstats.
 			static std::list<Stat> get();
 
-			/// @brief Get device sector size (in bytes).
+			/// @brief Get device logical block size (in bytes).
+			/// @details The value is cached by major:minor until the device is removed or the
+			/// system root changes; it comes from sysfs, the device is opened only when sysfs
+			/// lacks the information.
 			size_t blocksize() const;
 
+			/// @brief Drop the cached block size of a removed device, the numbers can be reused.
+			static void forget(unsigned int major, unsigned int minor) noexcept;
+
 			Stat & operator+=(const Stat &s);
 
 			inline bool operator==(const Stat &s) const {
@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/stat.h>
+ #include <cstdint>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Per-CPU counters from /proc/stat in structure-of-arrays layout.
+		/// @details Every array has the same length, padded to a multiple of 'lanes'; the padding
+		/// and the offline CPUs are kept as zero so the delta kernel can run without tail loops.
+		class UDJAT_API CpuSet {
+		public:
+
+			/// @brief Number of CPUs processed on each step of the delta kernel.
+			static constexpr size_t lanes = 4;
+
+			/// @brief Number of CPU slots (highest cpu number + 1).
+			size_t count = 0;
+
+			std::vector<uint64_t> user;			///< @brief user + nice ticks.
+			std::vector<uint64_t> system;		///< @brief system + irq + softirq ticks.
+			std::vector<uint64_t> idle;			///< @brief idle ticks.
+			std::vector<uint64_t> iowait;		///< @brief iowait ticks.
+			std::vector<uint64_t> steal;		///< @brief steal ticks.
+			std::vector<uint64_t> online;		///< @brief All bits set if the CPU was online.
+
+			/// @brief Per-CPU fractions computed from two snapshots.
+			struct UDJAT_API Usage {
+
+				size_t count = 0;				///< @brief Number of CPU slots.
+
+				std::vector<float> user;		///< @brief Fraction of time in user mode.
+				std::vector<float> system;		///< @brief Fraction of time in kernel mode (including interrupts).
+				std::vector<float> iowait;		///< @brief Fraction of time waiting for I/O.
+				std::vector<float> steal;		///< @brief Fraction of time stolen by the hypervisor.
+				std::vector<float> busy;		///< @brief Fraction of non idle time.
+				std::vector<uint8_t> valid;		///< @brief Non zero if the CPU was online on both samples.
+
+				/// @brief Compute fractions from two snapshots.
+				/// @param from The older snapshot.
+				/// @param to The newer snapshot.
+				void compute(const CpuSet &from, const CpuSet &to);
+
+			};
+
+			/// @brief Build empty set.
+			CpuSet() = default;
+
+			/// @brief Build set from parsed /proc/stat.
+			CpuSet(const Stats &stats);
+
+			/// @brief Load counters from parsed /proc/stat, reusing the arrays.
+			void set(const Stats &stats);
+
+			/// @brief Padded length of the arrays.
+			inline size_t size() const noexcept {
+				return user.size();
+			}
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/value.h>
+ #include <functional>
+ #include <mutex>
+ #include <string>
+ #include <cstdint>
+ #include <vector>
+ #include <ctime>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Fixed size history of values.
+		/// @details Ring buffer with timestamps and values in separate arrays, allocated
+		/// once when the depth is set; adding a sample never allocates. Optional rollup
+		/// tiers keep min/max/sum/count/last for fixed time buckets, updated as the samples
+		/// arrive.
+		class UDJAT_API History {
+		public:
+
+			/// @brief Rollup tier definition.
+			struct Resolution {
+				unsigned int width;		///< @brief Bucket width in seconds.
+				size_t depth;			///< @brief Number of buckets to keep.
+			};
+
+			/// @brief Ring header, followed by 'depth' timestamps (int64_t) and 'depth' values (float).
+			/// @details Same layout in memory and in the persistent history file.
+			struct Segment {
+				uint64_t head;					///< @brief Position of the next sample.
+				uint64_t count;					///< @brief Number of stored samples.
+				uint32_t depth;					///< @brief Number of samples.
+				uint32_t flags;					///< @brief Segment flags.
+				double baseline[6];				///< @brief Counters saved by the owner (ex: last disk counters).
+			};
+
+			/// @brief The baseline values are valid (same boot).
+			static constexpr uint32_t BaselineValid = 1;
+
+		private:
+
+			/// @brief Rollup tier, one bucket per 'width' seconds.
+			struct Tier {
+
+				unsigned int width = 60;
+
+				std::vector<time_t> start;			///< @brief Bucket start time.
+				std::vector<float> min;				///< @brief Minimum value in bucket.
+				std::vector<float> max;				///< @brief Maximum value in bucket.
+				std::vector<double> sum;			///< @brief Sum of the values in bucket.
+				std::vector<float> last;			///< @brief Last value in bucket.
+				std::vector<unsigned int> count;	///< @brief Number of values in bucket.
+
+				size_t head = 0;					///< @brief Position of the current bucket.
+				size_t used = 0;					///< @brief Number of used buckets.
+
+				Tier(const Resolution &resolution);
+
+				void push_back(float value, time_t timestamp) noexcept;
+
+			};
+
+			mutable std::mutex guard;
+
+			std::vector<Tier> tiers;
+
+			/// @brief In memory ring header.
+			Segment local{};
+
+			std::vector<int64_t> timestamps;	///< @brief In memory sample times.
+			std::vector<float> values;			///< @brief In memory sample values.
+
+			/// @brief The active ring (in memory or mapped from the history file).
+			struct {
+				Segment *header = nullptr;
+				int64_t *timestamps = nullptr;
+				float *values = nullptr;
+			} ring;
+
+			/// @brief Name in the persistent history file, empty if not persistent.
+			std::string name;
+
+			/// @brief Number of samples exported on the agent properties.
+			size_t exported = 60;
+
+			/// @brief Attach ring to the history file, fallback to memory.
+			void attach(size_t depth);
+
+		public:
+
+			/// @brief Build history.
+			/// @param depth Number of samples to keep, 0 disables the history.
+			History(size_t depth = 0);
+
+			/// @brief Build history from the 'history', 'rollup' and 'history-properties' attributes.
+			/// @details 'rollup' is 'true' for the default tiers (60 one minute buckets, 96 of
+			/// fifteen minutes and 168 of one hour) or a list of 'seconds:buckets' (ex: '60:1440,3600:720').
+			/// If the node has a 'state-dir' attribute (or UDJAT_STATE_DIR is set) the samples are kept
+			/// in the persistent history file, with the node name as key.
+			History(const XML::Node &node, const char *attrname = "history");
+
+			History(const History &) = delete;
+			History & operator=(const History &) = delete;
+
+			/// @brief Set depth, clears the stored samples (unless persistent with the same depth).
+			void resize(size_t depth);
+
+			/// @brief Keep samples in the persistent history file.
+			/// @param name The unique name for this history.
+			/// @return true if the history is persistent.
+			bool persist(const char *name);
+
+			/// @brief Get saved counters.
+			/// @param values Receives the saved counters.
+			/// @param length Number of counters (up to 6).
+			/// @return false if there are no valid counters (first run or reboot).
+			bool restore(double *values, size_t length) const noexcept;
+
+			/// @brief Save counters.
+			void save(const double *values, size_t length) noexcept;
+
+			/// @brief Set rollup tiers, clears the stored buckets.
+			void rollup(const std::vector<Resolution> &resolutions);
+
+			/// @brief Set rollup tiers from text ('true' or 'seconds:buckets,...').
+			void rollup(const char *spec);
+
+			/// @brief Get the depth.
+			inline size_t capacity() const noexcept {
+				return ring.header->depth;
+			}
+
+			/// @brief Is the history enabled?
+			inline operator bool() const noexcept {
+				return !(ring.header->depth == 0 && tiers.empty());
+			}
+
+			/// @brief Get the number of stored samples.
+			size_t size() const noexcept;
+
+			/// @brief Add sample.
+			void push_back(float value, time_t timestamp = time(0)) noexcept;
+
+			/// @brief Navigate from the oldest sample to the newest one.
+			void for_each(const std::function<void(time_t timestamp, float value)> &method) const;
+
+			/// @brief Get the bucket width of every rollup tier.
+			std::vector<unsigned int> widths() const;
+
+			/// @brief Navigate on the buckets of a rollup tier, from the oldest to the newest.
+			/// @param width The bucket width.
+			/// @return false if there's no tier with the requested width.
+			bool for_each(unsigned int width, const std::function<void(time_t start, float min, float max, float avg, float last, unsigned int count)> &method) const;
+
+			/// @brief Export samples.
+			/// @param value Receives one child for every sample, with 'time' and 'value'; the rollup
+			/// tiers are exported as 'rollup/[width]', with 'time', 'min', 'max', 'avg', 'last' and 'count'.
+			/// @param fraction If true the values are exported as fractions (percentage).
+			Udjat::Value & get(Udjat::Value &value, bool fraction = false) const;
+
+			/// @brief Export the newest samples for the agent properties.
+			/// @details Only the 'history-properties' newest samples (60 by default, 0 for none) and
+			/// no rollup tiers; the properties are built on every request, the complete history is
+			/// exported by get().
+			/// @param value Receives one child for every sample, with 'time' and 'value'.
+			/// @param fraction If true the values are exported as fractions (percentage).
+			Udjat::Value & properties(Udjat::Value &value, bool fraction = false) const;
+
+		};
+
+	}
+
+ }
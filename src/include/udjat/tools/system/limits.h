@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/handler.h>
+ #include <string>
+ #include <mutex>
+ #include <vector>
+ #include <memory>
+
+ namespace Udjat {
+
+	namespace System {
+
+		class Source;
+
+		/// @brief Resource limits of the current process (cpu affinity and cgroup v2).
+		/// @details The limits are detected on first use and reloaded when the kernel reports
+		/// a change on the cgroup limit files; used by the agents that report against the
+		/// container limits instead of the host totals.
+		class UDJAT_API Limits : private MainLoop::Handler {
+		private:
+
+			mutable std::recursive_mutex guard;
+
+			/// @brief System::Root generation of the detected limits.
+			unsigned int generation = 0;
+
+			/// @brief The cgroup of the current process, relative to /sys/fs/cgroup.
+			std::string path;
+
+			/// @brief The inotify watches.
+			std::vector<int> watches;
+
+			/// @brief Number of cpus in the affinity mask.
+			unsigned int affinity = 0;
+
+			/// @brief Effective cpus (affinity and cpu.max), 0 if not detected.
+			float cpus = 0;
+
+			/// @brief Effective memory limit in bytes (memory.max and memory.high), 0 if unlimited.
+			unsigned long long memory = 0;
+
+			/// @brief Time of the last /proc/self/cgroup check (System::Root::now()).
+			unsigned long long verified = 0;
+
+			/// @brief memory.current and memory.stat of the current cgroup, empty if not available.
+			struct {
+				std::unique_ptr<Source> current;
+				std::unique_ptr<Source> stat;
+			} usage;
+
+			Limits();
+
+			/// @brief Get the cgroup of the current process from /proc/self/cgroup.
+			static std::string detect();
+
+			/// @brief Detect limits if not detected, if the root has changed or if the process
+			/// was moved to another cgroup (checked every minute).
+			void check();
+
+			/// @brief Detect limits.
+			void load();
+
+			/// @brief Watch the limit files.
+			void watch(const std::string &filename);
+
+			void handle_event(const Event event) override;
+
+		public:
+
+			static Limits & getInstance();
+			~Limits();
+
+			/// @brief Get the cgroup of the current process (relative to /sys/fs/cgroup).
+			std::string cgroup();
+
+			/// @brief Get the effective number of cpus.
+			/// @param total The number of cpus on the host, returned if there's no limit.
+			float cores(float total);
+
+			/// @brief Get the effective memory.
+			/// @param total The host memory in bytes (MemTotal), returned if there's no limit.
+			unsigned long long memtotal(unsigned long long total);
+
+			/// @brief Get the memory in use by the cgroup of the current process (memory.current
+			/// without the inactive file cache), in bytes.
+			/// @return The memory in use, 0 if not available.
+			unsigned long long memused();
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <functional>
+ #include <string>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Library-wide root for procfs/sysfs paths.
+		/// @details The root is taken from the UDJAT_SYSTEM_ROOT environment variable or from
+		/// the 'system-root' option of the [sysinfo] configuration group; with UDJAT_SYSTEM_REPLAY
+		/// (or 'system-replay') the files are read from a directory of recorded snapshots, one
+		/// subdirectory for each sample named after its timestamp in milliseconds
+		/// (ex: 'replay/1700000000000/proc/stat'). The root is process-wide, it's loaded once
+		/// by the module and never from the agent definitions.
+		class UDJAT_API Root {
+		public:
+
+			/// @brief Clock returning milliseconds.
+			typedef std::function<unsigned long long()> Clock;
+
+			/// @brief Set the root directory ("" or "/" for the live system).
+			static void set(const char *path);
+
+			/// @brief Set root from the 'system-root' and 'system-replay' attributes, if present.
+			/// @details For applications embedding the library; changes the process-wide root.
+			static void set(const XML::Node &node);
+
+			/// @brief Load root and replay settings from the environment and the configuration.
+			/// @details Called once, when the module is loaded.
+			/// @exception std::system_error if the replay directory is invalid.
+			static void setup();
+
+			/// @brief Get the path of a procfs/sysfs file under the current root.
+			static std::string path(const char *path);
+
+			/// @brief Get the root generation, changed every time the root or the replay step changes.
+			/// @details Used by System::Source to reopen files after a change.
+			static unsigned int generation() noexcept;
+
+			/// @brief Start replay mode.
+			/// @param path Directory with the recorded snapshots.
+			/// @return The number of snapshots found.
+			static size_t replay(const char *path);
+
+			/// @brief Check if replay mode is active.
+			static bool replaying() noexcept;
+
+			/// @brief Step to the next recorded snapshot.
+			/// @return false if there are no more snapshots.
+			static bool next();
+
+			/// @brief Get the current time in milliseconds (monotonic).
+			/// @details In replay mode it's the timestamp of the current snapshot.
+			static unsigned long long now();
+
+			/// @brief Inject a clock, empty to restore the default one.
+			static void clock(const Clock &clock);
+
+		};
+
+	}
+
+ }
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <mutex>
+ #include <ctime>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief System counters collected at the same time.
+		struct UDJAT_API Snapshot {
+
+			unsigned long long timestamp = 0;	///< @brief Collection time (System::Root::now(), in milliseconds).
+			time_t time = 0;					///< @brief Collection time (wall clock).
+
+			long uptime = 0;					///< @brief Seconds since boot.
+			double loadavg[3] = { 0, 0, 0 };	///< @brief 1, 5, and 15 minute load averages.
+			unsigned short procs = 0;			///< @brief Number of current processes.
+
+			unsigned long long memtotal = 0;	///< @brief Total usable memory (MemTotal) in bytes.
+			unsigned long long memavailable = 0;///< @brief Available memory (MemAvailable) in bytes.
+
+			unsigned long long totalswap = 0;	///< @brief Total swap space in bytes.
+			unsigned long long freeswap = 0;	///< @brief Free swap space in bytes.
+
+		};
+
+		/// @brief Memoized system snapshot.
+		/// @details Keeps the last System::Snapshot; agents refreshed on the same tick get the
+		/// same collection instead of reading procfs again.
+		class UDJAT_API Sampler {
+		private:
+
+			mutable std::mutex guard;
+
+			/// @brief The last snapshot.
+			Snapshot last;
+
+			/// @brief System::Root generation of the last snapshot.
+			unsigned int generation = 0;
+
+			Sampler();
+
+			/// @brief Collect system counters.
+			void collect(Snapshot &snapshot);
+
+		public:
+
+			static Sampler & getInstance();
+
+			/// @brief Get a snapshot.
+			/// @param max_age Maximum age (in milliseconds) of the returned snapshot; a new one
+			/// is collected if the last one is older.
+			Snapshot get(unsigned long max_age = 0);
+
+		};
+
+	}
+
+ }
@@ -21,11 +21,15 @@
 
  #include <udjat/defs.h>
  #include <pugixml.hpp>
+ #include <vector>
+ #include <memory>
 
  namespace Udjat {
 
 	namespace System {
 
+		class Source;
+
 		/// @brief Disk stats from /proc/stat.
 		struct UDJAT_API Stat {
 
@@ -92,6 +96,39 @@
 
 		};
 
+		/// @brief Full contents of /proc/stat, parsed in a single pass.
+		/// @details The file descriptor, the read buffer and the per-cpu table are kept between calls
+		/// to refresh(), after the first sample no heap allocation is made unless the number of CPUs grows.
+		class UDJAT_API Stats {
+		private:
+
+			/// @brief Persistent handle for /proc/stat.
+			std::shared_ptr<Source> source;
+
+		public:
+
+			Stat cpu;								///< @brief The aggregate "cpu" row.
+			std::vector<Stat> cpus;					///< @brief The "cpuN" rows, indexed by cpu number.
+			std::vector<bool> online;				///< @brief True if the "cpuN" row was present in the last sample.
+
+			unsigned long long intr = 0;			///< @brief Total of interrupts serviced since boot.
+			unsigned long long ctxt = 0;			///< @brief Number of context switches since boot.
+			unsigned long long btime = 0;			///< @brief Boot time, in seconds since the epoch.
+			unsigned long long processes = 0;		///< @brief Number of forks since boot.
+			unsigned long procs_running = 0;		///< @brief Number of processes in runnable state.
+			unsigned long procs_blocked = 0;		///< @brief Number of processes blocked waiting for I/O.
+
+			/// @brief Build object with data from /proc/stat.
+			Stats();
+
+			/// @brief Reload data from /proc/stat.
+			void refresh();
+
+			/// @brief Parse the contents of a /proc/stat file.
+			void set(const char *text);
+
+		};
+
 	}
 
  }
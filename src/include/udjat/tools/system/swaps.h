@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Swap devices and compressed swap tiers.
+		struct UDJAT_API Swaps {
+
+			/// @brief Swap device or file from /proc/swaps.
+			struct Device {
+
+				std::string name;				///< @brief The device or file name.
+				std::string type;				///< @brief The swap type (partition, file).
+				unsigned long long size = 0;	///< @brief Swap size in bytes.
+				unsigned long long used = 0;	///< @brief Used swap in bytes.
+				int priority = 0;				///< @brief Swap priority.
+
+				/// @brief zram statistics (from /sys/block/zram?/mm_stat).
+				struct {
+					bool valid = false;					///< @brief True if the device is a zram one.
+					unsigned long long original = 0;	///< @brief Uncompressed size of the stored data in bytes.
+					unsigned long long compressed = 0;	///< @brief Compressed size of the stored data in bytes.
+					unsigned long long memory = 0;		///< @brief Memory used by the device, including allocator overhead.
+					float ratio = 0;					///< @brief Compression ratio (original/memory), 0 if empty.
+				} zram;
+
+			};
+
+			/// @brief The active swap devices.
+			std::vector<Device> devices;
+
+			/// @brief Total swap size in bytes.
+			unsigned long long size = 0;
+
+			/// @brief Total used swap in bytes.
+			unsigned long long used = 0;
+
+			/// @brief zswap state.
+			struct {
+				bool enabled = false;				///< @brief True if zswap is enabled.
+				std::string compressor;				///< @brief The compression algorithm.
+				unsigned int max_pool_percent = 0;	///< @brief Pool limit, in percent of the total memory.
+				unsigned long long pool = 0;		///< @brief Memory used by the compressed pool (meminfo Zswap) in bytes.
+				unsigned long long stored = 0;		///< @brief Uncompressed size of the stored pages (meminfo Zswapped) in bytes.
+				float ratio = 0;					///< @brief Compression ratio (stored/pool), 0 if empty.
+				unsigned long long in = 0;			///< @brief Pages loaded from the pool (vmstat zswpin).
+				unsigned long long out = 0;			///< @brief Pages stored on the pool (vmstat zswpout).
+			} zswap;
+
+			/// @brief Time of the last zswap parameters reload (System::Root::now()).
+			unsigned long long reloaded = 0;
+
+			/// @brief Read /proc/swaps, zram and zswap statistics.
+			/// @details The zswap parameters (enabled, compressor and max_pool_percent) are
+			/// reloaded every minute.
+			void refresh();
+
+		};
+
+	}
+
+ }
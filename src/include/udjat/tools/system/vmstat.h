@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <mutex>
+
+ namespace Udjat {
+
+	namespace System {
+
+		/// @brief Paging, swapping and reclaim counters from /proc/vmstat.
+		/// @details Shared by the vmstat agents and action; the reads are shared, the rates are
+		/// computed by every consumer against its own baseline (VmCounters::Rates), so a reader
+		/// with a shorter interval doesn't change the rate window of the others.
+		class UDJAT_API VmCounters {
+		public:
+
+			/// @brief The watched counters.
+			enum Counter : unsigned char {
+				SwapIn,				///< @brief Pages swapped in (pswpin).
+				SwapOut,			///< @brief Pages swapped out (pswpout).
+				Faults,				///< @brief Page faults (pgfault).
+				MajorFaults,		///< @brief Major page faults (pgmajfault).
+				ScanKswapd,			///< @brief Pages scanned by kswapd (pgscan_kswapd).
+				ScanDirect,			///< @brief Pages scanned by direct reclaim (pgscan_direct).
+				StealKswapd,		///< @brief Pages reclaimed by kswapd (pgsteal_kswapd).
+				StealDirect,		///< @brief Pages reclaimed by direct reclaim (pgsteal_direct).
+				AllocStall,			///< @brief Direct reclaim stalls, all zones (allocstall).
+				CompactStall,		///< @brief Direct compaction stalls (compact_stall).
+				OomKill,			///< @brief Processes killed by the OOM killer (oom_kill).
+				ZswapIn,			///< @brief Pages loaded from zswap (zswpin).
+				ZswapOut,			///< @brief Pages stored on zswap (zswpout).
+
+				COUNT
+			};
+
+			/// @brief Get counter from name (the /proc/vmstat key).
+			static Counter CounterFactory(const char *name);
+
+			/// @brief Get counter from the 'field-name' attribute.
+			static Counter CounterFactory(const XML::Node &node, const char *def = "pgmajfault");
+
+			/// @brief Get the /proc/vmstat key.
+			static const char * name(const Counter counter) noexcept;
+
+			/// @brief Rates between two updates, one for every consumer.
+			class UDJAT_API Rates {
+			private:
+
+				mutable std::mutex guard;
+
+				/// @brief Time of the baseline (System::Root::now()).
+				unsigned long long timestamp = 0;
+
+				/// @brief Counters on the baseline.
+				unsigned long long totals[COUNT];
+
+				/// @brief Rates (per second) between the last two updates.
+				float values[COUNT];
+
+				/// @brief Fraction of the scanned pages reclaimed between the last two updates.
+				float reclaimed = 1;
+
+			public:
+
+				Rates();
+
+				/// @brief Compute rates from the baseline to the last read, set the new baseline.
+				void update(const VmCounters &counters);
+
+				/// @brief Get the counter rate (per second).
+				float operator[](const Counter counter) const;
+
+				/// @brief Get the reclaim efficiency (pgsteal/pgscan), 1 if nothing was scanned.
+				float efficiency() const;
+
+			};
+
+		private:
+
+			mutable std::mutex guard;
+
+			/// @brief Time of the last read (System::Root::now()).
+			unsigned long long timestamp = 0;
+
+			/// @brief Counters from the last read.
+			unsigned long long totals[COUNT];
+
+			VmCounters();
+
+		public:
+
+			static VmCounters & getInstance();
+
+			/// @brief Read /proc/vmstat.
+			/// @param max_age Maximum age (in milliseconds) of the last read; the file is read
+			/// again if the last read is older.
+			void refresh(unsigned long max_age = 0);
+
+			/// @brief Get the counter value from the last read.
+			unsigned long long total(const Counter counter) const;
+
+		};
+
+	}
+
+ }
+
+ namespace std {
+
+	UDJAT_API const char * to_string(const Udjat::System::VmCounters::Counter counter) noexcept;
+
+ }
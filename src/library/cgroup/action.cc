@@ -0,0 +1,118 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/action.h>
+ #include <udjat/tools/actions/cgroup.h>
+ #include <udjat/tools/response.h>
+ #include <udjat/tools/report.h>
+ #include <private/cgroupcontroller.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <memory>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Udjat::Action> CGroup::Action::Factory::ActionFactory(const XML::Node &node) const {
+		return make_shared<CGroup::Action>(node);
+	}
+
+	CGroup::Action::Action(const XML::Node &node) : Udjat::Action{node}, unit{Storage::UnitFactory(node)} {
+
+		auto &controller = CGroup::Controller::getInstance();
+		controller.watch(
+			node.attribute("cgroup").as_string("system.slice"),
+			node.attribute("children").as_bool(true)
+		);
+		controller.setup(node);
+
+	}
+
+	CGroup::Action::~Action() {
+	}
+
+	void CGroup::Action::getValues(const Data &, Udjat::Value &) {
+		// Do nothing, it's just a placeholder.
+	}
+
+	/// @brief Fill report row.
+	static void row(const CGroup::Data &data, Udjat::Value &value, const Storage::Unit unit) {
+
+		value["cgroup"] = (string{"/"} + data.path).c_str();
+
+		value["cpu"] = data.cpu.usage;
+		value["user"] = data.cpu.user;
+		value["system"] = data.cpu.system;
+		value["throttled"].setFraction(data.cpu.throttled);
+		value["quota"] = data.cpu.quota;
+
+		value["memory"] = std::to_string((float) data.memory.current,unit);
+		value["limit"] = data.memory.max ? std::to_string((float) data.memory.max,unit) : string{"max"};
+		value["anon"] = std::to_string((float) data.memory.anon,unit);
+		value["file"] = std::to_string((float) data.memory.file,unit);
+		value["pgfault/s"] = data.memory.pgfault;
+		value["pgmajfault/s"] = data.memory.pgmajfault;
+
+		value["read"] = std::to_string(data.io.read,unit);
+		value["write"] = std::to_string(data.io.write,unit);
+		value["r/s"] = data.io.rios;
+		value["w/s"] = data.io.wios;
+
+		value["pids"] = (unsigned int) data.pids;
+
+	}
+
+	int CGroup::Action::call(Udjat::Request &request, Udjat::Response &response, bool except) {
+
+		return exec(response,except,[&]() -> int {
+
+			// Get the last published data, no copy, no lock.
+			auto snapshot = CGroup::Controller::getInstance().snapshot();
+			if(!snapshot || snapshot->empty()) {
+				throw system_error(ENODATA,system_category());
+			}
+
+			auto it = snapshot->begin();
+
+			// Get first line.
+			Value value;
+			row(*it,value,this->unit);
+			getValues(*it,value);
+
+			auto &report = response.ReportFactory(value);
+
+			while(++it != snapshot->end()) {
+				value.clear();
+				row(*it,value,this->unit);
+				getValues(*it,value);
+				report << value;
+			}
+
+			return 0;
+
+		});
+
+	}
+
+ }
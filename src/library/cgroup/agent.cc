@@ -0,0 +1,239 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/cgroup.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <private/cgroupcontroller.h>
+ #include <system_error>
+ #include <stdexcept>
+ #include <memory>
+ #include <unistd.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Abstract::Agent> CGroup::Usage::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<Usage>(node,resource);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	CGroup::Usage::Usage(const XML::Node &node, Resource r)
+		: Agent<Percentage>{node}, resource{r}, path{Controller::PathFactory(node.attribute("cgroup").as_string())}, history{node} {
+
+		auto &controller = Controller::getInstance();
+		controller.watch(path.c_str());
+		controller.setup(node);
+
+		Object::properties.icon = "utilities-system-monitor";
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = (resource == CPU ? _( "CGroup CPU usage" ) : _( "CGroup memory usage" ));
+		}
+
+	}
+
+	CGroup::Usage::~Usage() {
+	}
+
+	const CGroup::Data * CGroup::Usage::find(const std::vector<Data> &snapshot) const {
+
+		// The hint is shared by the callers (getProperties() is const), use a local copy.
+		size_t last = hint.load(std::memory_order_relaxed);
+		if(last < snapshot.size() && snapshot[last] == path.c_str()) {
+			return &snapshot[last];
+		}
+
+		for(size_t ix = 0; ix < snapshot.size(); ix++) {
+			if(snapshot[ix] == path.c_str()) {
+				hint.store(ix,std::memory_order_relaxed);
+				return &snapshot[ix];
+			}
+		}
+
+		return nullptr;
+
+	}
+
+	bool CGroup::Usage::refresh() {
+
+		// No I/O here, get values from the controller.
+		auto snapshot = Controller::getInstance().snapshot();
+
+		const Data *data = (snapshot ? find(*snapshot) : nullptr);
+		if(!data) {
+			throw system_error(ENOENT,system_category(),String{"Cgroup '/",path.c_str(),"' is not available"});
+		}
+
+		if(!data->error.empty()) {
+			throw runtime_error(data->error);
+		}
+
+		float value = 0;
+
+		if(resource == CPU) {
+
+			float cpus = data->cpu.quota;
+			if(cpus <= 0) {
+				cpus = (float) sysconf(_SC_NPROCESSORS_ONLN);
+			}
+
+			value = (cpus > 0 ? data->cpu.usage / cpus : 0);
+
+		} else {
+
+			unsigned long long limit = data->memory.max;
+			if(!limit) {
+				limit = System::Sampler::getInstance().get(60000).memtotal;
+			}
+
+			value = (limit ? ((float) data->memory.current) / ((float) limit) : 0);
+
+		}
+
+		if(value > 1) {
+			value = 1;
+		}
+
+		history.push_back(value);
+
+		return set(value);
+
+	}
+
+	Udjat::Value & CGroup::Usage::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		value["cgroup"] = (string{"/"} + path).c_str();
+
+		auto snapshot = Controller::getInstance().snapshot();
+		const Data *data = (snapshot ? find(*snapshot) : nullptr);
+
+		if(data) {
+
+			auto &cpu = value["cpu"];
+			cpu["usage"] = data->cpu.usage;
+			cpu["user"] = data->cpu.user;
+			cpu["system"] = data->cpu.system;
+			cpu["throttled"].setFraction(data->cpu.throttled);
+			cpu["quota"] = data->cpu.quota;
+
+			auto &memory = value["memory"];
+			memory["current"] = data->memory.current;
+			memory["max"] = data->memory.max;
+			memory["anon"] = data->memory.anon;
+			memory["file"] = data->memory.file;
+			memory["kernel"] = data->memory.kernel;
+			memory["sock"] = data->memory.sock;
+			memory["shmem"] = data->memory.shmem;
+			memory["pgfault"] = data->memory.pgfault;
+			memory["pgmajfault"] = data->memory.pgmajfault;
+
+			auto &io = value["io"];
+			io["read"] = data->io.read;
+			io["write"] = data->io.write;
+			io["rios"] = data->io.rios;
+			io["wios"] = data->io.wios;
+
+			value["pids"] = data->pids;
+
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> CGroup::Usage::computeState() {
+
+		float current = (float) this->get();
+		for(auto state : states) {
+			if(state->compare(current))
+				return state;
+		}
+
+		static const struct {
+			float value;			///< @brief State max value.
+			const char * name;		///< @brief State name.
+			Udjat::Level level;		///< @brief State level.
+			const char * summary;	///< @brief State summary.
+			const char * body;		///< @brief State description
+		} default_states[] = {
+			{
+				0.8,
+				"low",
+				Udjat::ready,
+				N_( "${value} of the cgroup limit in use" ),
+				""
+			},
+			{
+				0.9,
+				"medium",
+				Udjat::warning,
+				N_( "${value} of the cgroup limit in use" ),
+				""
+			},
+			{
+				1.01,
+				"high",
+				Udjat::error,
+				N_( "${value} of the cgroup limit in use" ),
+				""
+			}
+		};
+
+		for(const auto &state : default_states) {
+			if(current < state.value) {
+
+				return Abstract::Agent::StateFactory(
+					state.name,
+					state.level,
+#ifdef GETTEXT_PACKAGE
+							dgettext(GETTEXT_PACKAGE,state.summary),
+							dgettext(GETTEXT_PACKAGE,state.body)
+#else
+							state.summary,
+							state.body
+#endif // GETTEXT_PACKAGE
+				);
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }
@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/root.h>
+ #include <system_error>
+ #include <dirent.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <cstring>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "cgroup"
+ #include <udjat/tools/logger.h>
+
+ #include <private/cgroupcontroller.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	CGroup::Controller & CGroup::Controller::getInstance() {
+		static CGroup::Controller instance;
+		return instance;
+	}
+
+	std::string CGroup::Controller::PathFactory(const char *path) {
+
+		if(!path) {
+			return "";
+		}
+
+		while(*path == '/') {
+			path++;
+		}
+
+		std::string result{path};
+		while(!result.empty() && result.back() == '/') {
+			result.pop_back();
+		}
+
+		return result;
+
+	}
+
+	bool CGroup::Controller::push_back(const char *path) {
+
+		for(const auto &data : *this) {
+			if(data == path) {
+				return false;
+			}
+		}
+
+		Logger::String{"Watching cgroup '/",path,"'"}.trace();
+		emplace_back(path);
+
+		return true;
+
+	}
+
+	void CGroup::Controller::watch(const char *path, bool children) {
+
+		std::string name{PathFactory(path)};
+
+		for(const auto &watch : watches) {
+			if(watch.path == name && watch.children == children) {
+				return;
+			}
+		}
+
+		watches.push_back({name,children});
+
+		if(children) {
+			rescan();
+		} else {
+			push_back(name.c_str());
+		}
+
+		publish();
+
+	}
+
+	void CGroup::Controller::rescan() {
+
+		rescanned = System::Root::now();
+
+		// The limits could be changed at any time (systemctl set-property, ...).
+		for(auto &data : *this) {
+			try {
+				data.limits();
+			} catch(const std::exception &e) {
+				Logger::String{"Error reading limits of '/",data.path.c_str(),"': ",e.what()}.warning();
+			}
+		}
+
+		for(const auto &watch : watches) {
+
+			if(!watch.children) {
+				push_back(watch.path.c_str());
+				continue;
+			}
+
+			std::string dirname{System::Root::path((string{"/sys/fs/cgroup/"} + watch.path).c_str())};
+
+			DIR *dir = opendir(dirname.c_str());
+			if(!dir) {
+				Logger::String{"Can't scan '",dirname.c_str(),"': ",strerror(errno)}.warning();
+				continue;
+			}
+
+			struct dirent *entry;
+			while((entry = readdir(dir)) != NULL) {
+
+				if(entry->d_name[0] == '.') {
+					continue;
+				}
+
+				if(entry->d_type == DT_UNKNOWN) {
+					struct stat st;
+					if(fstatat(dirfd(dir),entry->d_name,&st,AT_SYMLINK_NOFOLLOW) || !S_ISDIR(st.st_mode)) {
+						continue;
+					}
+				} else if(entry->d_type != DT_DIR) {
+					continue;
+				}
+
+				if(watch.path.empty()) {
+					push_back(entry->d_name);
+				} else {
+					push_back((watch.path + "/" + entry->d_name).c_str());
+				}
+
+			}
+
+			closedir(dir);
+
+		}
+
+	}
+
+	void CGroup::Controller::setup(const XML::Node &node) {
+
+		const char *domain = node.attribute("name").as_string(LOG_DOMAIN);
+
+		Updater::setup(node,domain,1000L);
+		Updater::autoupdate(domain);
+
+		rescan_interval = ((unsigned long long) node.attribute("rescan-interval").as_uint(rescan_interval/1000)) * 1000;
+		if(!rescanned) {
+			rescanned = System::Root::now();
+		}
+
+	}
+
+	void CGroup::Controller::on_timer() {
+
+		try {
+
+			for(size_t ix = size(); ix-- > 0;) {
+
+				Data &data = at(ix);
+
+				try {
+
+					data.refresh();
+					data.error.clear();
+
+				} catch(const std::system_error &e) {
+
+					if(e.code().value() == ENOENT || e.code().value() == ENODEV) {
+						// The cgroup was removed.
+						Logger::String{"Removing cgroup '/",data.path.c_str(),"'"}.trace();
+						erase(std::vector<Data>::begin() + ix);
+						continue;
+					}
+
+					data.error = e.what();
+					Logger::String{"Error updating cgroup '/",data.path.c_str(),"': ",e.what()}.error();
+
+				} catch(const std::exception &e) {
+
+					data.error = e.what();
+					Logger::String{"Error updating cgroup '/",data.path.c_str(),"': ",e.what()}.error();
+
+				}
+
+			}
+
+			// New children are found on rescan.
+			if(rescan_interval && System::Root::now() >= (rescanned + rescan_interval)) {
+				rescan();
+			}
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error on cgroup controller: ",e.what()}.error();
+
+		}
+
+		publish();
+
+	}
+
+ }
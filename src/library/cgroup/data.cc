@@ -0,0 +1,241 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/cgroupcontroller.h>
+ #include <private/keyedparser.h>
+ #include <private/scanner.h>
+ #include <system_error>
+ #include <string>
+ #include <cstring>
+ #include <unistd.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get counter delta, zero if the counter was reset.
+	static inline double delta(unsigned long long current, unsigned long long previous) noexcept {
+		return current >= previous ? (double) (current - previous) : 0;
+	}
+
+	/// @brief Build source if the file exists (the controller could be disabled for this cgroup).
+	static std::shared_ptr<System::Source> SourceFactory(const std::string &filename, size_t size) {
+		if(access(System::Root::path(filename.c_str()).c_str(),R_OK)) {
+			return std::shared_ptr<System::Source>();
+		}
+		return std::make_shared<System::Source>(filename.c_str(),size);
+	}
+
+	/// @brief Read a single value file (memory.current, pids.current, ...).
+	static unsigned long long single(System::Source &source) {
+
+		char buffer[32];
+		const char *ptr = buffer;
+		unsigned long long value = 0;
+
+		source.read(buffer,sizeof(buffer));
+		if(!Scanner::number(ptr,value)) {
+			throw system_error(EINVAL,system_category(),string{"Unexpected format in '"} + source.name() + "'");
+		}
+
+		return value;
+	}
+
+	CGroup::Data::Data(const char *p) : path{p} {
+
+		// https://docs.kernel.org/admin-guide/cgroup-v2.html
+		sources.cpu = std::make_shared<System::Source>(filename("cpu.stat").c_str(),512);
+		sources.memory = SourceFactory(filename("memory.current"),32);
+		sources.memstat = SourceFactory(filename("memory.stat"),2048);
+		sources.io = SourceFactory(filename("io.stat"),256);
+		sources.pids = SourceFactory(filename("pids.current"),32);
+
+		limits();
+
+	}
+
+	std::string CGroup::Data::filename(const char *name) const {
+		if(path.empty()) {
+			return string{"/sys/fs/cgroup/"} + name;
+		}
+		return string{"/sys/fs/cgroup/"} + path + "/" + name;
+	}
+
+	void CGroup::Data::limits() {
+
+		cpu.quota = 0;
+		memory.max = 0;
+
+		// cpu.max: "$MAX $PERIOD", "max" when unlimited.
+		{
+			auto source = SourceFactory(filename("cpu.max"),64);
+			if(source) {
+				char buffer[64];
+				const char *ptr = buffer;
+				unsigned long long quota, period;
+				source->read(buffer,sizeof(buffer));
+				if(Scanner::number(ptr,quota) && Scanner::number(ptr,period) && period) {
+					cpu.quota = ((float) quota) / ((float) period);
+				}
+			}
+		}
+
+		// memory.max: bytes, "max" when unlimited.
+		{
+			auto source = SourceFactory(filename("memory.max"),32);
+			if(source) {
+				char buffer[32];
+				const char *ptr = buffer;
+				unsigned long long value;
+				source->read(buffer,sizeof(buffer));
+				if(Scanner::number(ptr,value)) {
+					memory.max = value;
+				}
+			}
+		}
+
+	}
+
+	void CGroup::Data::refresh() {
+
+		unsigned long long now = System::Root::now();
+
+		// cpu.stat, allways present on cgroup v2.
+		unsigned long long cpustat[4];
+		{
+			static const System::KeyedParser parser{"usage_usec","user_usec","system_usec","throttled_usec"};
+			parser.parse(sources.cpu->read(),cpustat);
+		}
+
+		if(sources.memory) {
+			memory.current = single(*sources.memory);
+		}
+
+		unsigned long long memstat[7] = {0,0,0,0,0,0,0};
+		if(sources.memstat) {
+			static const System::KeyedParser parser{"anon","file","kernel","sock","shmem","pgfault","pgmajfault"};
+			parser.parse(sources.memstat->read(),memstat);
+			memory.anon = memstat[0];
+			memory.file = memstat[1];
+			memory.kernel = memstat[2];
+			memory.sock = memstat[3];
+			memory.shmem = memstat[4];
+		}
+
+		// io.stat: "$MAJ:$MIN rbytes=N wbytes=N rios=N wios=N dbytes=N dios=N", one line per device.
+		unsigned long long iostat[4] = {0,0,0,0};
+		if(sources.io) {
+
+			static const struct {
+				const char *key;
+				size_t length;
+			} keys[] = {
+				{ "rbytes", 6 },
+				{ "wbytes", 6 },
+				{ "rios", 4 },
+				{ "wios", 4 },
+			};
+
+			for(const char *ptr = sources.io->read(); *ptr; ptr = Scanner::eol(ptr)) {
+
+				// Skip device number.
+				ptr = Scanner::word(Scanner::blanks(ptr));
+
+				while(*ptr && *ptr != '\n') {
+
+					ptr = Scanner::blanks(ptr);
+
+					const char *key = ptr;
+					while(*ptr && *ptr != '=' && *ptr != ' ' && *ptr != '\n') {
+						ptr++;
+					}
+
+					if(*ptr != '=') {
+						ptr = Scanner::word(ptr);
+						continue;
+					}
+
+					size_t length = (size_t) (ptr - key);
+					ptr++;
+
+					unsigned long long value;
+					if(!Scanner::number(ptr,value)) {
+						ptr = Scanner::word(ptr);
+						continue;
+					}
+
+					for(size_t ix = 0; ix < 4; ix++) {
+						if(keys[ix].length == length && !strncmp(keys[ix].key,key,length)) {
+							iostat[ix] += value;
+							break;
+						}
+					}
+
+				}
+
+			}
+
+		}
+
+		if(sources.pids) {
+			pids = single(*sources.pids);
+		}
+
+		if(last.timestamp && now > last.timestamp) {
+
+			double interval = (double) (now - last.timestamp);	// milliseconds
+			double usecs = interval * 1000.0;
+			double seconds = interval / 1000.0;
+
+			cpu.usage = delta(cpustat[0],last.usage) / usecs;
+			cpu.user = delta(cpustat[1],last.user) / usecs;
+			cpu.system = delta(cpustat[2],last.system) / usecs;
+			cpu.throttled = delta(cpustat[3],last.throttled) / usecs;
+
+			if(cpu.throttled > 1) {
+				cpu.throttled = 1;
+			}
+
+			memory.pgfault = delta(memstat[5],last.pgfault) / seconds;
+			memory.pgmajfault = delta(memstat[6],last.pgmajfault) / seconds;
+
+			io.read = delta(iostat[0],last.io[0]) / seconds;
+			io.write = delta(iostat[1],last.io[1]) / seconds;
+			io.rios = delta(iostat[2],last.io[2]) / seconds;
+			io.wios = delta(iostat[3],last.io[3]) / seconds;
+
+		}
+
+		last.timestamp = now;
+		last.usage = cpustat[0];
+		last.user = cpustat[1];
+		last.system = cpustat[2];
+		last.throttled = cpustat[3];
+		last.pgfault = memstat[5];
+		last.pgmajfault = memstat[6];
+		for(size_t ix = 0; ix < 4; ix++) {
+			last.io[ix] = iostat[ix];
+		}
+
+	}
+
+ }
@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/timer.h>
+ #include <udjat/tools/logger.h>
+ #include <private/controller.h>
+
+ namespace Udjat {
+
+	void System::Updater::setup(const XML::Node &node, const char *domain, unsigned long fallback) {
+
+		auto saved_interval = Timer::interval();
+		if(!saved_interval) {
+			saved_interval = fallback;
+		}
+
+		Timer::set(node);
+
+		if(saved_interval < Timer::interval() || Timer::interval() == 0) {
+			Timer::set(saved_interval);
+			Logger::String{"Keeping original timer of ",Timer::interval(),"ms"}.trace(domain);
+		} else {
+			Logger::String{"Update timer set to ",Timer::interval(),"ms"}.trace(domain);
+		}
+
+	}
+
+	void System::Updater::autoupdate(const char *domain) {
+		if(Timer::enable()) {
+			Logger::String{"Auto update was enabled"}.trace(domain);
+		}
+	}
+
+ }
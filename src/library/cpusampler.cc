@@ -0,0 +1,257 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/cpuset.h>
+ #include <private/cpusampler.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "cpu"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get the elapsed ticks, without guest time.
+	/// @details Guest and guest_nice are already accounted in user and nice; same total of
+	/// the per-core fractions (System::CpuSet), the aggregate and per-core values share a scale.
+	static inline unsigned long ticks(const System::Stat &stat) noexcept {
+		return stat.total() - stat.guest - stat.guest_nice;
+	}
+
+	/// @brief Get fraction of time spent on 'type' between two samples.
+	static float fraction(const System::Stat &from, const System::Stat &to, System::Stat::Type type) noexcept {
+
+		float total = (float) (ticks(to) - ticks(from));
+		if(total <= 0) {
+			return 0;
+		}
+
+		if(type == System::Stat::TOTAL) {
+			// Busy time, everything but idle.
+			return ((float) ((ticks(to) - to.idle) - (ticks(from) - from.idle))) / total;
+		}
+
+		return ((float) (to[type] - from[type])) / total;
+
+	}
+
+	System::CpuSampler & System::CpuSampler::getInstance() {
+		static CpuSampler instance;
+		return instance;
+	}
+
+	System::CpuSampler::CpuSampler() {
+
+		previous = current.cpu;
+		cpus = current.cpus;
+		sets[newest].set(current);
+
+		for(size_t ix = 0; ix < Stat::TOTAL; ix++) {
+			values[ix] = 0;
+		}
+
+	}
+
+	void System::CpuSampler::push_back(const void *id, unsigned long interval, const std::function<void()> &callback) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(!interval) {
+			interval = 1000;
+		}
+
+		for(auto &subscriber : subscribers) {
+			if(subscriber.id == id) {
+				subscriber.interval = interval;
+				subscriber.callback = callback;
+				reset();
+				return;
+			}
+		}
+
+		subscribers.push_back({id,interval,callback});
+		reset();
+
+	}
+
+	void System::CpuSampler::remove(const void *id) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		for(auto it = subscribers.begin(); it != subscribers.end(); it++) {
+			if(it->id == id) {
+				subscribers.erase(it);
+				break;
+			}
+		}
+
+		reset();
+
+	}
+
+	void System::CpuSampler::reset() {
+
+		if(subscribers.empty()) {
+			Timer::disable();
+			return;
+		}
+
+		unsigned long interval = subscribers[0].interval;
+		for(const auto &subscriber : subscribers) {
+			if(subscriber.interval < interval) {
+				interval = subscriber.interval;
+			}
+		}
+
+		if(interval != Timer::interval()) {
+			Logger::String{"Sampling /proc/stat every ",interval,"ms for ",subscribers.size()," agent(s)"}.trace();
+			Timer::set(interval);
+		}
+
+		Timer::enable();
+
+	}
+
+	void System::CpuSampler::sample() {
+
+		// Keep the last sample; same sizes, the copy will not allocate.
+		previous = current.cpu;
+		cpus = current.cpus;
+
+		current.refresh();
+
+		float total = (float) (ticks(current.cpu) - ticks(previous));
+		for(size_t ix = 0; ix < Stat::TOTAL; ix++) {
+			if(total > 0) {
+				values[ix] = ((float) (current.cpu[(Stat::Type) ix] - previous[(Stat::Type) ix])) / total;
+			} else {
+				values[ix] = 0;
+			}
+		}
+
+		newest ^= 1;
+		sets[newest].set(current);
+		cores.compute(sets[newest ^ 1],sets[newest]);
+
+		samples++;
+
+	}
+
+	void System::CpuSampler::on_timer() {
+
+		std::vector<std::function<void()>> callbacks;
+
+		{
+			std::lock_guard<std::mutex> lock(guard);
+
+			try {
+
+				sample();
+
+			} catch(const std::exception &e) {
+
+				Logger::String{"Error reading /proc/stat: ",e.what()}.error();
+				return;
+
+			}
+
+			callbacks.reserve(subscribers.size());
+			for(const auto &subscriber : subscribers) {
+				if(subscriber.callback) {
+					callbacks.push_back(subscriber.callback);
+				}
+			}
+
+		}
+
+		// Notify without lock, the subscribers will call get().
+		for(auto &callback : callbacks) {
+			try {
+				callback();
+			} catch(const std::exception &e) {
+				Logger::String{"Error updating cpu agent: ",e.what()}.error();
+			}
+		}
+
+	}
+
+	float System::CpuSampler::get(Stat::Type type, int cpu) const {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(!samples) {
+			return 0;
+		}
+
+		if(cpu == -1) {
+
+			// Aggregate value.
+			if(type < Stat::TOTAL) {
+				return values[type];
+			}
+
+			float total = 0;
+			for(size_t ix = 0; ix < Stat::TOTAL; ix++) {
+				total += values[ix];
+			}
+
+			// Guest time is already accounted in user and nice.
+			return total - values[Stat::IDLE] - values[Stat::GUEST] - values[Stat::GUEST_NICE];
+
+		}
+
+		size_t length = std::min(cpus.size(),current.cpus.size());
+
+		if(cpu == -2) {
+
+			// Busiest cpu.
+			float rc = 0;
+			for(size_t ix = 0; ix < length; ix++) {
+				if(current.online[ix]) {
+					float value = fraction(cpus[ix],current.cpus[ix],type);
+					if(value > rc) {
+						rc = value;
+					}
+				}
+			}
+			return rc;
+
+		}
+
+		if(cpu < 0 || ((size_t) cpu) >= length || !current.online[cpu]) {
+			// Offline or unknown cpu.
+			return 0;
+		}
+
+		return fraction(cpus[cpu],current.cpus[cpu],type);
+
+	}
+
+	void System::CpuSampler::get(const std::function<void(const CpuSet::Usage &)> &callback) const {
+		std::lock_guard<std::mutex> lock(guard);
+		callback(cores);
+	}
+
+ }
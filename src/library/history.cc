@@ -0,0 +1,420 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/history.h>
+ #include <private/historyfile.h>
+ #include <udjat/tools/timestamp.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/xml.h>
+ #include <string>
+ #include <cstdlib>
+ #include <cstring>
+ #include <system_error>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	System::History::History(size_t depth) {
+		ring.header = &local;
+		resize(depth);
+	}
+
+	System::History::History(const XML::Node &node, const char *attrname) {
+
+		ring.header = &local;
+
+		size_t depth = XML::AttributeFactory(node,attrname).as_uint(0);
+
+		if(depth && HistoryFile::getInstance().open(node)) {
+			name = node.attribute("name").as_string("");
+		}
+
+		resize(depth);
+		rollup(XML::AttributeFactory(node,"rollup").as_string(""));
+
+		exported = XML::AttributeFactory(node,"history-properties").as_uint(60);
+
+	}
+
+	System::History::Tier::Tier(const Resolution &resolution) : width{resolution.width ? resolution.width : 1} {
+		start.resize(resolution.depth);
+		min.resize(resolution.depth);
+		max.resize(resolution.depth);
+		sum.resize(resolution.depth);
+		last.resize(resolution.depth);
+		count.resize(resolution.depth);
+	}
+
+	void System::History::Tier::push_back(float value, time_t timestamp) noexcept {
+
+		if(start.empty()) {
+			return;
+		}
+
+		time_t bucket = timestamp - (timestamp % width);
+
+		if(!used || bucket > start[head]) {
+
+			// Open a new bucket.
+			if(used) {
+				if(++head == start.size()) {
+					head = 0;
+				}
+			}
+
+			if(used < start.size()) {
+				used++;
+			}
+
+			start[head] = bucket;
+			min[head] = max[head] = last[head] = value;
+			sum[head] = value;
+			count[head] = 1;
+			return;
+
+		}
+
+		// Same bucket (or the clock went back), accumulate.
+		if(value < min[head]) {
+			min[head] = value;
+		}
+		if(value > max[head]) {
+			max[head] = value;
+		}
+		sum[head] += value;
+		last[head] = value;
+		count[head]++;
+
+	}
+
+	void System::History::rollup(const std::vector<Resolution> &resolutions) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		tiers.clear();
+		tiers.reserve(resolutions.size());
+		for(const auto &resolution : resolutions) {
+			if(resolution.depth) {
+				tiers.emplace_back(resolution);
+			}
+		}
+
+	}
+
+	void System::History::rollup(const char *spec) {
+
+		if(!(spec && *spec) || !strcasecmp(spec,"false") || !strcasecmp(spec,"no")) {
+			rollup(std::vector<Resolution>{});
+			return;
+		}
+
+		if(!strcasecmp(spec,"true") || !strcasecmp(spec,"yes")) {
+			rollup(std::vector<Resolution>{ {60,60}, {900,96}, {3600,168} });
+			return;
+		}
+
+		// List of 'seconds:buckets'.
+		std::vector<Resolution> resolutions;
+		const char *ptr = spec;
+		while(*ptr) {
+
+			char *end = nullptr;
+			unsigned long width = strtoul(ptr,&end,10);
+			if(!end || *end != ':' || !width) {
+				throw system_error(EINVAL,system_category(),string{"Invalid rollup definition '"} + spec + "'");
+			}
+
+			ptr = end+1;
+			unsigned long depth = strtoul(ptr,&end,10);
+			if(!end || end == ptr) {
+				throw system_error(EINVAL,system_category(),string{"Invalid rollup definition '"} + spec + "'");
+			}
+
+			resolutions.push_back({(unsigned int) width,(size_t) depth});
+
+			ptr = end;
+			while(*ptr == ',' || *ptr == ' ') {
+				ptr++;
+			}
+
+		}
+
+		rollup(resolutions);
+
+	}
+
+	void System::History::attach(size_t depth) {
+
+		if(!name.empty() && depth) {
+
+			Segment *segment = HistoryFile::getInstance().get(name.c_str(),depth);
+			if(segment) {
+
+				// Samples from the previous run are kept.
+				ring.header = segment;
+				ring.timestamps = (int64_t *) (segment+1);
+				ring.values = (float *) (ring.timestamps + depth);
+
+				timestamps.clear();
+				values.clear();
+				timestamps.shrink_to_fit();
+				values.shrink_to_fit();
+				return;
+
+			}
+
+		}
+
+		local.head = local.count = 0;
+		local.depth = (uint32_t) depth;
+		local.flags = 0;
+
+		timestamps.assign(depth,0);
+		values.assign(depth,0);
+		timestamps.shrink_to_fit();
+		values.shrink_to_fit();
+
+		ring.header = &local;
+		ring.timestamps = timestamps.data();
+		ring.values = values.data();
+
+	}
+
+	void System::History::resize(size_t depth) {
+		std::lock_guard<std::mutex> lock(guard);
+		attach(depth);
+	}
+
+	bool System::History::persist(const char *n) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		name = n;
+		attach(ring.header->depth);
+
+		return ring.header != &local;
+
+	}
+
+	bool System::History::restore(double *dst, size_t length) const noexcept {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(!(ring.header->flags & BaselineValid)) {
+			return false;
+		}
+
+		for(size_t ix = 0; ix < length && ix < (sizeof(Segment::baseline)/sizeof(Segment::baseline[0])); ix++) {
+			dst[ix] = ring.header->baseline[ix];
+		}
+
+		return true;
+
+	}
+
+	void System::History::save(const double *src, size_t length) noexcept {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		for(size_t ix = 0; ix < length && ix < (sizeof(Segment::baseline)/sizeof(Segment::baseline[0])); ix++) {
+			ring.header->baseline[ix] = src[ix];
+		}
+
+		ring.header->flags |= BaselineValid;
+
+	}
+
+	size_t System::History::size() const noexcept {
+		std::lock_guard<std::mutex> lock(guard);
+		return (size_t) ring.header->count;
+	}
+
+	void System::History::push_back(float value, time_t timestamp) noexcept {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		// O(1) for every tier, no rescan of the raw samples.
+		for(auto &tier : tiers) {
+			tier.push_back(value,timestamp);
+		}
+
+		Segment &header = *ring.header;
+
+		if(!header.depth) {
+			return;
+		}
+
+		// Plain stores, the history file is synchronized by a timer.
+		ring.timestamps[header.head] = (int64_t) timestamp;
+		ring.values[header.head] = value;
+
+		if(++header.head >= header.depth) {
+			header.head = 0;
+		}
+
+		if(header.count < header.depth) {
+			header.count++;
+		}
+
+	}
+
+	void System::History::for_each(const std::function<void(time_t timestamp, float value)> &method) const {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		const Segment &header = *ring.header;
+		if(!header.depth) {
+			return;
+		}
+
+		// The oldest sample is 'count' positions before head.
+		size_t ix = (header.head + header.depth - header.count) % header.depth;
+
+		for(size_t step = 0; step < header.count; step++) {
+			method((time_t) ring.timestamps[ix],ring.values[ix]);
+			if(++ix == header.depth) {
+				ix = 0;
+			}
+		}
+
+	}
+
+	std::vector<unsigned int> System::History::widths() const {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		std::vector<unsigned int> rc;
+		rc.reserve(tiers.size());
+		for(const auto &tier : tiers) {
+			rc.push_back(tier.width);
+		}
+
+		return rc;
+
+	}
+
+	bool System::History::for_each(unsigned int width, const std::function<void(time_t start, float min, float max, float avg, float last, unsigned int count)> &method) const {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		for(const auto &tier : tiers) {
+
+			if(tier.width != width) {
+				continue;
+			}
+
+			size_t ix = (tier.head + 1 + tier.start.size() - tier.used) % tier.start.size();
+
+			for(size_t step = 0; step < tier.used; step++) {
+				method(tier.start[ix],tier.min[ix],tier.max[ix],(float) (tier.sum[ix] / tier.count[ix]),tier.last[ix],tier.count[ix]);
+				if(++ix == tier.start.size()) {
+					ix = 0;
+				}
+			}
+
+			return true;
+
+		}
+
+		return false;
+
+	}
+
+	Udjat::Value & System::History::get(Udjat::Value &value, bool fraction) const {
+
+		size_t index = 0;
+
+		for_each([&](time_t timestamp, float sample){
+
+			auto &row = value[std::to_string(index++).c_str()];
+			row["time"] = TimeStamp{timestamp};
+
+			if(fraction) {
+				row["value"].setFraction(sample);
+			} else {
+				row["value"] = sample;
+			}
+
+		});
+
+		for(auto width : widths()) {
+
+			auto &buckets = value["rollup"][std::to_string(width).c_str()];
+			index = 0;
+
+			for_each(width,[&](time_t start, float min, float max, float avg, float last, unsigned int count){
+
+				auto &row = buckets[std::to_string(index++).c_str()];
+				row["time"] = TimeStamp{start};
+				row["count"] = count;
+
+				if(fraction) {
+					row["min"].setFraction(min);
+					row["max"].setFraction(max);
+					row["avg"].setFraction(avg);
+					row["last"].setFraction(last);
+				} else {
+					row["min"] = min;
+					row["max"] = max;
+					row["avg"] = avg;
+					row["last"] = last;
+				}
+
+			});
+
+		}
+
+		return value;
+
+	}
+
+	Udjat::Value & System::History::properties(Udjat::Value &value, bool fraction) const {
+
+		// Skip the older samples, without copying them.
+		size_t skip = size();
+		skip = (skip > exported ? skip - exported : 0);
+
+		size_t index = 0;
+
+		for_each([&](time_t timestamp, float sample){
+
+			if(skip) {
+				skip--;
+				return;
+			}
+
+			auto &row = value[std::to_string(index++).c_str()];
+			row["time"] = TimeStamp{timestamp};
+
+			if(fraction) {
+				row["value"].setFraction(sample);
+			} else {
+				row["value"] = sample;
+			}
+
+		});
+
+		return value;
+
+	}
+
+ }
@@ -0,0 +1,202 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/keyedparser.h>
+ #include <private/scanner.h>
+ #include <system_error>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Check for end of key.
+	static inline bool delimiter(char chr) noexcept {
+		return chr == ':' || chr == ' ' || chr == '\t' || chr == '\n' || !chr;
+	}
+
+	uint32_t System::KeyedParser::hash(uint32_t seed, const char *str, size_t length) noexcept {
+
+		// FNV-1a
+		uint32_t rc = 2166136261U ^ seed;
+		for(size_t ix = 0; ix < length; ix++) {
+			rc ^= (uint8_t) str[ix];
+			rc *= 16777619U;
+		}
+		return rc ^ (rc >> 16);
+
+	}
+
+	System::KeyedParser::KeyedParser(std::initializer_list<const char *> names) {
+
+		if(names.size() > 0x7fff) {
+			throw system_error(E2BIG,system_category(),"Too many keys");
+		}
+
+		// The value indexes are the list positions, a duplicated key can't be merged
+		// and would never get a collision free table.
+		keys.reserve(names.size());
+		for(const char *name : names) {
+			for(const auto &key : keys) {
+				if(key.name == name) {
+					throw system_error(EINVAL,system_category(),string{"Duplicated key '"} + name + "'");
+				}
+			}
+			keys.push_back({name,0});
+		}
+
+		compile();
+
+	}
+
+	size_t System::KeyedParser::push_back(const char *name) {
+
+		size_t length = strlen(name);
+
+		for(size_t ix = 0; ix < keys.size(); ix++) {
+			if(keys[ix].name.size() == length && !memcmp(keys[ix].name.c_str(),name,length)) {
+				return ix;
+			}
+		}
+
+		if(keys.size() >= 0x7fff) {
+			throw system_error(E2BIG,system_category(),"Too many keys");
+		}
+
+		keys.push_back({name,0});
+		compile();
+
+		return keys.size()-1;
+
+	}
+
+	void System::KeyedParser::compile() {
+
+		// Start with a load factor of at most 50% and search for a collision free seed,
+		// doubling the table when no seed is found.
+		size_t size = 8;
+		while(size < (keys.size() * 2)) {
+			size <<= 1;
+		}
+
+		while(true) {
+
+			uint32_t m = (uint32_t) (size - 1);
+
+			for(uint32_t s = 0; s < 1024; s++) {
+
+				table.assign(size,-1);
+
+				bool ok = true;
+				for(size_t ix = 0; ok && ix < keys.size(); ix++) {
+					uint32_t h = hash(s,keys[ix].name.c_str(),keys[ix].name.size());
+					if(table[h & m] >= 0) {
+						ok = false;
+					} else {
+						table[h & m] = (int16_t) ix;
+						keys[ix].hash = h;
+					}
+				}
+
+				if(ok) {
+					seed = s;
+					mask = m;
+					return;
+				}
+
+			}
+
+			size <<= 1;
+
+		}
+
+	}
+
+	size_t System::KeyedParser::parse(const char *text, unsigned long long *values) const noexcept {
+
+		size_t found = 0;
+
+		for(size_t ix = 0; ix < keys.size(); ix++) {
+			values[ix] = 0;
+		}
+
+		if(keys.empty()) {
+			return 0;
+		}
+
+		for(const char *ptr = text; *ptr && found < keys.size(); ptr = Scanner::eol(ptr)) {
+
+			const char *key = Scanner::blanks(ptr);
+
+			// Hash the key while searching for its end.
+			uint32_t h = 2166136261U ^ seed;
+			const char *end = key;
+			while(!delimiter(*end)) {
+				h ^= (uint8_t) *end;
+				h *= 16777619U;
+				end++;
+			}
+			h ^= (h >> 16);
+
+			int16_t index = table[h & mask];
+			if(index < 0) {
+				continue;
+			}
+
+			const Key &entry = keys[index];
+			size_t length = (size_t) (end - key);
+			if(entry.hash != h || entry.name.size() != length || memcmp(entry.name.c_str(),key,length)) {
+				continue;
+			}
+
+			if(*end == ':') {
+				end++;
+			}
+
+			unsigned long long value;
+			if(!Scanner::number(end,value)) {
+				continue;
+			}
+
+			end = Scanner::blanks(end);
+			if(*end == 'k') {
+				value *= 1024;
+			} else if(*end == 'M') {
+				value *= 1024 * 1024;
+			}
+
+			values[index] = value;
+			found++;
+
+		}
+
+		return found;
+
+	}
+
+	size_t System::KeyedParser::parse(const char *text, std::vector<unsigned long long> &values) const {
+		if(values.size() != keys.size()) {
+			values.resize(keys.size());
+		}
+		return parse(text,values.data());
+	}
+
+ }
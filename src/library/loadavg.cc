@@ -35,18 +35,229 @@
  #include <udjat/agent/abstract.h>
  #include <udjat/agent/percentage.h>
  #include <udjat/agent/loadavg.h>
- #include <udjat/tools/file/text.h>
  #include <udjat/tools/intl.h>
  #include <udjat/tools/logger.h>
  #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/system/limits.h>
+ #include <private/source.h>
+ #include <private/scanner.h>
+ #include <private/keyedparser.h>
  #include <sstream>
  #include <iomanip>
  #include <memory>
+ #include <mutex>
+ #include <vector>
+ #include <cmath>
+ #include <cstring>
+ #include <system_error>
 
  using namespace std;
 
  namespace Udjat {
 
+	/// @brief Exponentially weighted averages of the runnable tasks, sampled at sub-second intervals.
+	class System::LoadAverage::Estimator : private MainLoop::Timer {
+	private:
+
+		mutable std::mutex guard;
+
+		LoadAverage &agent;
+
+		/// @brief Publish interval (in milliseconds), 0 if published by the agent update timer.
+		unsigned long long publish = 0;
+
+		/// @brief Time of the last publish (System::Root::now()).
+		unsigned long long published = 0;
+
+		/// @brief Read procs_running/procs_blocked from /proc/stat instead of /proc/loadavg.
+		bool stat = false;
+
+		struct Window {
+			unsigned int seconds;	///< @brief The average window (in seconds).
+			double value;			///< @brief The current average.
+		};
+
+		/// @brief The averages, the first one is the agent value.
+		std::vector<Window> windows;
+
+		/// @brief Time of the last sample (System::Root::now()).
+		unsigned long long timestamp = 0;
+
+		/// @brief Runnable tasks on the last sample.
+		unsigned long long running = 0;
+
+		/// @brief Tasks blocked on I/O on the last sample (only from /proc/stat).
+		unsigned long long blocked = 0;
+
+		void sample() {
+
+			unsigned long long running = 0, blocked = 0;
+
+			{
+				// The sources are shared by all estimators.
+				static std::mutex sources;
+				std::lock_guard<std::mutex> lock(sources);
+
+				if(stat) {
+
+					// /proc/stat is larger, but it has the blocked tasks, like the kernel load average.
+					static System::Source source{"/proc/stat",16384};
+					static const KeyedParser parser{"procs_running","procs_blocked"};
+
+					unsigned long long values[2];
+					if(parser.parse(source.read(),values) != 2) {
+						throw system_error(EINVAL,system_category(),"Unexpected format in /proc/stat");
+					}
+
+					running = values[0];
+					blocked = values[1];
+
+				} else {
+
+					// /proc/loadavg: 1, 5 and 15 minute averages, running/total entities.
+					static System::Source source{"/proc/loadavg",128};
+
+					char buffer[128];
+					const char *ptr = buffer;
+					double average;
+
+					source.read(buffer,sizeof(buffer));
+					if(!(Scanner::decimal(ptr,average)
+							&& Scanner::decimal(ptr,average)
+							&& Scanner::decimal(ptr,average)
+							&& Scanner::number(ptr,running))) {
+						throw system_error(EINVAL,system_category(),"Unexpected format in /proc/loadavg");
+					}
+
+				}
+			}
+
+			// The reader is one of the running tasks.
+			if(running) {
+				running--;
+			}
+
+			double current = (double) (running + blocked);
+			unsigned long long now = Root::now();
+
+			std::lock_guard<std::mutex> lock(guard);
+
+			if(!timestamp) {
+
+				for(auto &window : windows) {
+					window.value = current;
+				}
+
+			} else if(now > timestamp) {
+
+				// The timer is not exact, weight every sample by the elapsed time.
+				double elapsed = ((double) (now - timestamp)) / 1000.0;
+				for(auto &window : windows) {
+					window.value += (1.0 - exp(-elapsed / ((double) window.seconds))) * (current - window.value);
+				}
+
+			}
+
+			timestamp = now;
+			this->running = running;
+			this->blocked = blocked;
+
+		}
+
+	protected:
+
+		void on_timer() override {
+
+			try {
+				sample();
+			} catch(const std::exception &e) {
+				Logger::String{"Error sampling runnable tasks: ",e.what()}.error();
+				return;
+			}
+
+			if(publish) {
+				unsigned long long now = Root::now();
+				if(now >= (published + publish)) {
+					published = now;
+					agent.refresh();
+				}
+			}
+
+		}
+
+	public:
+
+		Estimator(LoadAverage &a, const XML::Node &node) : agent{a} {
+
+			// The averages react within seconds, without an update-timer publish them every second.
+			if(!XML::AttributeFactory(node,"update-timer")) {
+				publish = 1000;
+			}
+
+			stat = !strcasecmp(XML::AttributeFactory(node,"load-source").as_string("loadavg"),"stat");
+
+			// Comma separated windows, in seconds.
+			const char *ptr = XML::AttributeFactory(node,"windows").as_string("5,30");
+			while(*ptr) {
+				unsigned int seconds;
+				if(!Scanner::number(ptr,seconds) || !seconds) {
+					throw system_error(EINVAL,system_category(),"The windows should be a list of seconds (ex: '5,30')");
+				}
+				windows.push_back({seconds,0});
+				ptr = Scanner::blanks(ptr);
+				if(*ptr == ',') {
+					ptr++;
+				}
+			}
+
+			if(windows.empty()) {
+				throw system_error(EINVAL,system_category(),"At least one window is required");
+			}
+
+			Timer::set(XML::AttributeFactory(node,"sample-interval").as_uint(250));
+
+		}
+
+		virtual ~Estimator() {
+			Timer::disable();
+		}
+
+		void start() {
+			sample();
+			Timer::enable();
+		}
+
+		void stop() {
+			Timer::disable();
+		}
+
+		/// @brief Get the first average.
+		double value() const {
+			std::lock_guard<std::mutex> lock(guard);
+			return windows[0].value;
+		}
+
+		void get(Udjat::Value &value, float cores) const {
+
+			std::lock_guard<std::mutex> lock(guard);
+
+			value["running"] = running;
+			value["blocked"] = blocked;
+			value["cores"] = cores;
+
+			auto &averages = value["averages"];
+			for(const auto &window : windows) {
+				averages[(std::to_string(window.seconds) + "s").c_str()] = (float) window.value;
+			}
+
+			// Runnable tasks per core, not truncated.
+			value["ratio"] = (float) (cores > 0 ? windows[0].value / cores : 0);
+
+		}
+
+	};
+
 	std::shared_ptr<Abstract::Agent> System::LoadAverage::Factory::AgentFactory(const XML::Node &node) const {
 		debug("--- Building Load Average agent");
 		return std::make_shared<LoadAverage>(node);
@@ -56,36 +267,77 @@
 		setup(5);
 	}
 
-	System::LoadAverage::LoadAverage(const XML::Node &node) : Agent<Percentage>{node} {
+	System::LoadAverage::LoadAverage(const XML::Node &node) : Agent<Percentage>{node}, history{node} {
+		if(XML::AttributeFactory(node,"high-resolution").as_bool(false)) {
+			estimator = std::make_unique<Estimator>(*this,node);
+		}
 		setup(XML::AttributeFactory(node,"minutes").as_uint(5));
+		container = XML::AttributeFactory(node,"container-limits").as_bool(false);
+		if(container) {
+			info() << "Effective CPU cores: " << Limits::getInstance().cores(cores) << endl;
+		}
 	}
 
 	System::LoadAverage::~LoadAverage() {
-
 	}
 
 	void System::LoadAverage::start() {
+
+		if(estimator) {
+			estimator->start();
+		}
+
 		refresh();
 		Abstract::Agent::start();
 	}
 
+	void System::LoadAverage::stop() {
+		if(estimator) {
+			estimator->stop();
+		}
+		Abstract::Agent::stop();
+	}
+
 	bool System::LoadAverage::refresh() {
 
-#ifdef HAS_GETLOADAVG
+		// Driven by the agent update timer; agents refreshed on the same tick share
+		// one snapshot.
+		auto snapshot = Sampler::getInstance().get(timer() * 500);
+
+		bool rc = update(snapshot);
+		history.push_back((float) this->get(),snapshot.time);
+
+		return rc;
+	}
+
+	float System::LoadAverage::effective() const {
+		// The limits are cached, reloaded only when the cgroup changes.
+		return container ? Limits::getInstance().cores(cores) : cores;
+	}
 
-		double loadavg[3];
+	bool System::LoadAverage::update(const Snapshot &snapshot) {
+
+		if(estimator) {
+
+			float rc = (float) (estimator->value() / effective());
+
+			if(rc > 1.0) {
+				rc = 1.0;
+			}
+
+			return Agent<Percentage>::set(rc);
 
-		if(getloadavg(loadavg,3) < 0) {
-			throw system_error(EINVAL,system_category(),_("Can't get system load average"));
 		}
 
-		float rc = loadavg[this->type] / ((double) this->cores);
+#ifdef HAS_GETLOADAVG
+
+		float rc = snapshot.loadavg[this->type] / ((double) effective());
 
-		if(rc > 100.0) {
-			rc = 100.0;
+		if(rc > 1.0) {
+			rc = 1.0;
 		}
 
-		return Agent<Percentage>::set((float) (rc/100));
+		return Agent<Percentage>::set(rc);
 #else
 
 		logger::String{"No support for getloadavg() function"}.error(name());
@@ -95,6 +347,29 @@
 
 	}
 
+	Udjat::Value & System::LoadAverage::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		if(estimator) {
+			try {
+				estimator->get(value["high-resolution"],effective());
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting load estimator: ",e.what()}.error(name());
+			}
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
 	static inline bool is_empty(const char *str) noexcept {
 		return !(str && *str);
 	}
@@ -107,10 +382,15 @@
 		// Identify the number of cores.
 		//
 		{
+			// Shared by all load average agents.
+			static std::mutex guard;
+			static System::Source cpuinfo{"/proc/cpuinfo",65536};
+
+			std::lock_guard<std::mutex> lock(guard);
+
 			cores = 0;
-			Udjat::File::Text cpuinfo("/proc/cpuinfo");
-			for(auto line : cpuinfo) {
-				if(!strncasecmp(line->c_str(),"processor",9)) {
+			for(const char *ptr = cpuinfo.read(); *ptr; ptr = Scanner::eol(ptr)) {
+				if(!strncasecmp(ptr,"processor",9)) {
 					cores++;
 				}
 			}
@@ -122,6 +402,26 @@
 		//
 		Object::properties.icon = "utilities-system-monitor";
 
+		if(estimator) {
+
+			if(is_empty(Object::properties.label)) {
+#ifdef GETTEXT_PACKAGE
+				Object::properties.label = dgettext(GETTEXT_PACKAGE,N_( "Runnable tasks per core" ));
+#else
+				Object::properties.label = N_( "Runnable tasks per core" );
+#endif
+			}
+
+			if(is_empty(Object::properties.summary)) {
+#ifdef GETTEXT_PACKAGE
+				Object::properties.summary = dgettext(GETTEXT_PACKAGE,N_( "Average of the runnable tasks per core in the last seconds" ));
+#else
+				Object::properties.summary = N_( "Average of the runnable tasks per core in the last seconds" );
+#endif
+			}
+
+		}
+
 		static const struct {
 			uint8_t minutes;
 			const char *label;
@@ -153,7 +453,7 @@
 
 		for(size_t type = 0; type < (sizeof(types)/sizeof(types[0])); type++) {
 			if(minutes == types[type].minutes) {
-				type = type;
+				this->type = type;
 
 				if(is_empty(Object::properties.label)) {
 #ifdef GETTEXT_PACKAGE
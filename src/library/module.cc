@@ -20,10 +20,13 @@
  #include <config.h>
  #include <udjat/defs.h>
  #include <udjat/module/sysinfo.h>
+ #include <udjat/tools/system/root.h>
 
  namespace Udjat {
 
 	SysInfo::Module::Module(const char *name) : Udjat::Module(name) {
+		// Process-wide, a bad replay directory fails the module load.
+		System::Root::setup();
 	}
 
 	SysInfo::Module::~Module() {	
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/action.h>
+ #include <udjat/tools/actions/network.h>
+ #include <udjat/tools/response.h>
+ #include <udjat/tools/report.h>
+ #include <private/networkcontroller.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <memory>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Udjat::Action> Network::Action::Factory::ActionFactory(const XML::Node &node) const {
+		return make_shared<Network::Action>(node);
+	}
+
+	Network::Action::Action(const XML::Node &node) : Udjat::Action{node}, unit{Storage::UnitFactory(node)} {
+		Network::Controller::getInstance().setup(node);
+	}
+
+	Network::Action::~Action() {
+	}
+
+	void Network::Action::getValues(const Data &, Udjat::Value &) {
+		// Do nothing, it's just a placeholder.
+	}
+
+	/// @brief Fill report row.
+	static void row(const Network::Data &data, Udjat::Value &value, const Storage::Unit unit) {
+
+		value["interface"] = data.name.c_str();
+		value["speed"] = (unsigned int) (data.speed / 1000000ULL);	// Mbits/s, same as sysfs.
+
+		value["rx"] = std::to_string(data.rx.bytes,unit);
+		value["tx"] = std::to_string(data.tx.bytes,unit);
+		value["rxpck/s"] = data.rx.packets;
+		value["txpck/s"] = data.tx.packets;
+		value["rxerr/s"] = data.rx.errors;
+		value["txerr/s"] = data.tx.errors;
+		value["rxdrop/s"] = data.rx.drops;
+		value["txdrop/s"] = data.tx.drops;
+		value["util"].setFraction(data.utilization);
+
+	}
+
+	int Network::Action::call(Udjat::Request &request, Udjat::Response &response, bool except) {
+
+		return exec(response,except,[&]() -> int {
+
+			// Get the last published data, no copy, no lock.
+			auto snapshot = Network::Controller::getInstance().snapshot();
+			if(!snapshot || snapshot->empty()) {
+				throw system_error(ENODATA,system_category());
+			}
+
+			auto it = snapshot->begin();
+
+			// Get first line.
+			Value value;
+			row(*it,value,this->unit);
+			getValues(*it,value);
+
+			auto &report = response.ReportFactory(value);
+
+			while(++it != snapshot->end()) {
+				value.clear();
+				row(*it,value,this->unit);
+				getValues(*it,value);
+				report << value;
+			}
+
+			return 0;
+
+		});
+
+	}
+
+ }
@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/network.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <private/networkcontroller.h>
+ #include <system_error>
+ #include <stdexcept>
+ #include <memory>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Abstract::Agent> Network::Interface::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<Interface>(node);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	Network::Interface::Interface(const XML::Node &node) : Agent<Percentage>{node}, history{node} {
+
+		ifname = String{node,"interface",""}.c_str();
+		if(ifname.empty()) {
+			ifname = node.attribute("name").as_string();
+		}
+
+		if(ifname.empty()) {
+			throw system_error(EINVAL,system_category(),"An interface name is required");
+		}
+
+		Controller::getInstance().setup(node);
+
+		Object::properties.icon = "network-wired";
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = _( "Network usage" );
+		}
+
+	}
+
+	Network::Interface::~Interface() {
+	}
+
+	const Network::Data * Network::Interface::find(const std::vector<Data> &snapshot) const {
+
+		// The hint is shared by the callers (getProperties() is const), use a local copy.
+		size_t last = hint.load(std::memory_order_relaxed);
+		if(last < snapshot.size() && snapshot[last] == ifname.c_str()) {
+			return &snapshot[last];
+		}
+
+		for(size_t ix = 0; ix < snapshot.size(); ix++) {
+			if(snapshot[ix] == ifname.c_str()) {
+				hint.store(ix,std::memory_order_relaxed);
+				return &snapshot[ix];
+			}
+		}
+
+		return nullptr;
+
+	}
+
+	bool Network::Interface::refresh() {
+
+		// No I/O here, get values from the controller.
+		auto snapshot = Controller::getInstance().snapshot();
+
+		const Data *data = (snapshot ? find(*snapshot) : nullptr);
+		if(!data) {
+			throw system_error(ENODEV,system_category(),String{"Interface '",ifname.c_str(),"' is not available"});
+		}
+
+		if(!data->error.empty()) {
+			throw runtime_error(data->error);
+		}
+
+		history.push_back(data->utilization);
+
+		return set(data->utilization);
+
+	}
+
+	Udjat::Value & Network::Interface::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		value["interface"] = ifname.c_str();
+
+		auto snapshot = Controller::getInstance().snapshot();
+		const Data *data = (snapshot ? find(*snapshot) : nullptr);
+
+		if(data) {
+
+			value["speed"] = data->speed;
+
+			auto &rx = value["rx"];
+			rx["bytes"] = data->rx.bytes;
+			rx["packets"] = data->rx.packets;
+			rx["errors"] = data->rx.errors;
+			rx["drops"] = data->rx.drops;
+
+			auto &tx = value["tx"];
+			tx["bytes"] = data->tx.bytes;
+			tx["packets"] = data->tx.packets;
+			tx["errors"] = data->tx.errors;
+			tx["drops"] = data->tx.drops;
+
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> Network::Interface::computeState() {
+
+		float current = (float) this->get();
+		for(auto state : states) {
+			if(state->compare(current))
+				return state;
+		}
+
+		static const struct {
+			float value;			///< @brief State max value.
+			const char * name;		///< @brief State name.
+			Udjat::Level level;		///< @brief State level.
+			const char * summary;	///< @brief State summary.
+			const char * body;		///< @brief State description
+		} default_states[] = {
+			{
+				0.7,
+				"low",
+				Udjat::ready,
+				N_( "${value} of link bandwidth in use" ),
+				""
+			},
+			{
+				0.9,
+				"medium",
+				Udjat::warning,
+				N_( "${value} of link bandwidth in use" ),
+				""
+			},
+			{
+				1.01,
+				"high",
+				Udjat::error,
+				N_( "${value} of link bandwidth in use" ),
+				""
+			}
+		};
+
+		for(const auto &state : default_states) {
+			if(current < state.value) {
+
+				return Abstract::Agent::StateFactory(
+					state.name,
+					state.level,
+#ifdef GETTEXT_PACKAGE
+							dgettext(GETTEXT_PACKAGE,state.summary),
+							dgettext(GETTEXT_PACKAGE,state.body)
+#else
+							state.summary,
+							state.body
+#endif // GETTEXT_PACKAGE
+				);
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }
@@ -0,0 +1,209 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/scanner.h>
+ #include <system_error>
+ #include <cstring>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "network"
+ #include <udjat/tools/logger.h>
+
+ #include <private/networkcontroller.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	Network::Controller & Network::Controller::getInstance() {
+		static Network::Controller instance;
+		return instance;
+	}
+
+	void Network::Controller::reindex() {
+
+		index.clear();
+		for(size_t ix = 0; ix < size(); ix++) {
+			index[at(ix).name] = ix;
+		}
+
+		found.assign(size(),false);
+
+	}
+
+	void Network::Controller::setup(const XML::Node &node) {
+
+		const char *domain = node.attribute("name").as_string(LOG_DOMAIN);
+
+		Updater::setup(node,domain,60000L);
+
+		if(node.attribute("loopback").as_bool(false)) {
+			loopback = true;
+		}
+
+		link_interval = ((unsigned long long) node.attribute("link-interval").as_uint(link_interval/1000)) * 1000;
+
+		if(published()) {
+			// Already started.
+			return;
+		}
+
+		// First sample, the rates are available on the next tick.
+		try {
+			refresh();
+		} catch(const std::exception &e) {
+			Logger::String{"Error reading network interfaces: ",e.what()}.error(domain);
+		}
+
+		publish();
+
+		Updater::autoupdate(domain);
+
+	}
+
+	void Network::Controller::refresh() {
+
+		unsigned long long now = System::Root::now();
+
+		for(size_t ix = 0; ix < found.size(); ix++) {
+			found[ix] = false;
+		}
+
+		// Reload the link speed, it changes on renegotiation.
+		bool relink = (link_interval && now >= (linked + link_interval));
+		if(relink) {
+			linked = now;
+			for(auto &data : *this) {
+				data.link();
+			}
+		}
+
+		// Interface names are shorter than IFNAMSIZ, no allocation for the lookup key.
+		std::string key;
+
+		// Skip the two header lines.
+		const char *ptr = Scanner::eol(Scanner::eol(netdev.read()));
+
+		for(; *ptr; ptr = Scanner::eol(ptr)) {
+
+			const char *name = Scanner::blanks(ptr);
+			const char *colon = name;
+			while(*colon && *colon != ':' && *colon != '\n') {
+				colon++;
+			}
+
+			if(*colon != ':') {
+				continue;
+			}
+
+			size_t length = (size_t) (colon - name);
+			if(!loopback && length == 2 && !strncmp(name,"lo",2)) {
+				continue;
+			}
+
+			// bytes packets errs drop fifo frame compressed multicast (receive)
+			// bytes packets errs drop fifo colls carrier compressed (transmit)
+			ptr = colon+1;
+			unsigned long long counters[16];
+			size_t count = 0;
+			while(count < 16 && Scanner::number(ptr,counters[count])) {
+				count++;
+			}
+
+			key.assign(name,length);
+
+			if(count < 16) {
+				Logger::String{"Unexpected format in /proc/net/dev for '",key.c_str(),"'"}.error();
+				continue;
+			}
+
+			size_t ix;
+			auto entry = index.find(key);
+			if(entry == index.end()) {
+
+				Logger::String{"Watching ",key.c_str()}.trace();
+
+				ix = size();
+				emplace_back(name,length);
+				back().link();
+				index[key] = ix;
+				found.push_back(false);
+
+			} else {
+
+				ix = entry->second;
+
+			}
+
+			Data &data = at(ix);
+			found[ix] = true;
+
+			try {
+
+				data.update(now,counters,counters+8);
+				data.error.clear();
+
+			} catch(const std::exception &e) {
+
+				data.error = e.what();
+				Logger::String{"Error updating interface status: ",e.what()}.error();
+
+			}
+
+		}
+
+		// Interfaces no longer in /proc/net/dev were removed.
+		bool removed = false;
+		for(size_t ix = found.size(); ix-- > 0;) {
+			if(!found[ix]) {
+				Logger::String{"Removing ",at(ix).name.c_str(),", not found in /proc/net/dev"}.trace();
+				erase(std::vector<Data>::begin() + ix);
+				removed = true;
+			}
+		}
+
+		if(removed) {
+			reindex();
+		}
+
+	}
+
+	void Network::Controller::on_timer() {
+
+		try {
+
+			refresh();
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error on network controller: ",e.what()}.error();
+
+		}
+
+		publish();
+
+	}
+
+ }
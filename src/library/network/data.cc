@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/networkcontroller.h>
+ #include <private/scanner.h>
+ #include <string>
+ #include <unistd.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Get counter delta, zero if the counter was reset.
+	static inline double delta(unsigned long long current, unsigned long long previous) noexcept {
+		return current >= previous ? (double) (current - previous) : 0;
+	}
+
+	Network::Data::Data(const char *n, size_t length) : name{n,length} {
+	}
+
+	void Network::Data::link() {
+
+		// https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-net
+		// Speed in Mbits/sec, -1 or EINVAL for virtual and disconnected interfaces.
+		speed = 0;
+
+		std::string path{String{"/sys/class/net/",name.c_str(),"/speed"}.c_str()};
+		if(access(System::Root::path(path.c_str()).c_str(),R_OK)) {
+			return;
+		}
+
+		try {
+
+			char buffer[32];
+			const char *ptr = buffer;
+			unsigned long long value;
+
+			System::Source source{path.c_str(),sizeof(buffer)};
+			source.read(buffer,sizeof(buffer));
+
+			if(Scanner::number(ptr,value)) {
+				speed = value * 1000000ULL;
+			}
+
+		} catch(const std::exception &) {
+
+			// No link speed.
+			speed = 0;
+
+		}
+
+	}
+
+	void Network::Data::update(unsigned long long now, const unsigned long long *counters_rx, const unsigned long long *counters_tx) {
+
+		if(last.timestamp && now > last.timestamp) {
+
+			double seconds = ((double) (now - last.timestamp)) / 1000.0;
+
+			rx.bytes = delta(counters_rx[Bytes],last.rx[Bytes]) / seconds;
+			rx.packets = delta(counters_rx[Packets],last.rx[Packets]) / seconds;
+			rx.errors = delta(counters_rx[Errors],last.rx[Errors]) / seconds;
+			rx.drops = delta(counters_rx[Drops],last.rx[Drops]) / seconds;
+
+			tx.bytes = delta(counters_tx[Bytes],last.tx[Bytes]) / seconds;
+			tx.packets = delta(counters_tx[Packets],last.tx[Packets]) / seconds;
+			tx.errors = delta(counters_tx[Errors],last.tx[Errors]) / seconds;
+			tx.drops = delta(counters_tx[Drops],last.tx[Drops]) / seconds;
+
+			// Full duplex, the busiest direction against the link speed.
+			if(speed) {
+				utilization = ((rx.bytes > tx.bytes ? rx.bytes : tx.bytes) * 8.0) / ((float) speed);
+				if(utilization > 1) {
+					utilization = 1;
+				}
+			} else {
+				utilization = 0;
+			}
+
+		}
+
+		last.timestamp = now;
+		for(size_t ix = 0; ix < 4; ix++) {
+			last.rx[ix] = counters_rx[ix];
+			last.tx[ix] = counters_tx[ix];
+		}
+
+	}
+
+ }
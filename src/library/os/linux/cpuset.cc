@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * The delta kernel uses the GCC vector extensions, the compiler lowers them to
+  * the best instruction set available (SSE, AVX, AVX-512, NEON) or to scalar code.
+  *
+  * https://gcc.gnu.org/onlinedocs/gcc/Vector-Extensions.html
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/cpuset.h>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	typedef uint64_t u64vector __attribute__((vector_size(System::CpuSet::lanes * sizeof(uint64_t))));
+	typedef int64_t  i64vector __attribute__((vector_size(System::CpuSet::lanes * sizeof(int64_t))));
+	typedef int32_t  i32vector __attribute__((vector_size(System::CpuSet::lanes * sizeof(int32_t))));
+	typedef float    f32vector __attribute__((vector_size(System::CpuSet::lanes * sizeof(float))));
+
+	static inline __attribute__((always_inline)) void load(u64vector &value, const std::vector<uint64_t> &values, size_t offset) noexcept {
+		if(offset < values.size()) {
+			memcpy(&value,values.data()+offset,sizeof(value));
+		} else {
+			// CPU block not present on this sample.
+			memset(&value,0,sizeof(value));
+		}
+	}
+
+	static inline __attribute__((always_inline)) void delta(u64vector &value, const std::vector<uint64_t> &from, const std::vector<uint64_t> &to, size_t offset) noexcept {
+		u64vector older;
+		load(older,from,offset);
+		load(value,to,offset);
+		value -= older;
+	}
+
+	static inline __attribute__((always_inline)) void store(std::vector<float> &values, size_t offset, const f32vector &value) noexcept {
+		memcpy(values.data()+offset,&value,sizeof(value));
+	}
+
+	static inline __attribute__((always_inline)) f32vector fraction(const u64vector &delta, const f32vector &scale) noexcept {
+		return __builtin_convertvector(__builtin_convertvector(delta,i32vector),f32vector) * scale;
+	}
+
+	System::CpuSet::CpuSet(const Stats &stats) {
+		set(stats);
+	}
+
+	void System::CpuSet::set(const Stats &stats) {
+
+		count = stats.cpus.size();
+
+		size_t length = ((count + lanes - 1) / lanes) * lanes;
+
+		user.resize(length);
+		system.resize(length);
+		idle.resize(length);
+		iowait.resize(length);
+		steal.resize(length);
+		online.resize(length);
+
+		for(size_t ix = 0; ix < length; ix++) {
+
+			if(ix < count && stats.online[ix]) {
+
+				const Stat &cpu = stats.cpus[ix];
+
+				// Guest time is already accounted in user time.
+				user[ix] = cpu.user + cpu.nice;
+				system[ix] = cpu.system + cpu.irq + cpu.softirq;
+				idle[ix] = cpu.idle;
+				iowait[ix] = cpu.iowait;
+				steal[ix] = cpu.steal;
+				online[ix] = ~((uint64_t) 0);
+
+			} else {
+
+				user[ix] = system[ix] = idle[ix] = iowait[ix] = steal[ix] = online[ix] = 0;
+
+			}
+
+		}
+
+	}
+
+	void System::CpuSet::Usage::compute(const CpuSet &from, const CpuSet &to) {
+
+		count = to.count;
+
+		size_t length = to.size();
+
+		user.resize(length);
+		system.resize(length);
+		iowait.resize(length);
+		steal.resize(length);
+		busy.resize(length);
+		valid.resize(length);
+
+		const f32vector zero = {};
+
+		for(size_t ix = 0; ix < length; ix += lanes) {
+
+			u64vector duser, dsystem, didle, diowait, dsteal;
+
+			delta(duser,from.user,to.user,ix);
+			delta(dsystem,from.system,to.system,ix);
+			delta(didle,from.idle,to.idle,ix);
+			delta(diowait,from.iowait,to.iowait,ix);
+			delta(dsteal,from.steal,to.steal,ix);
+
+			u64vector total = duser + dsystem + didle + diowait + dsteal;
+
+			// A CPU is valid if online on both samples, with monotonic counters and some elapsed time.
+			u64vector online, was_online;
+			load(was_online,from.online,ix);
+			load(online,to.online,ix);
+
+			i64vector mask = (i64vector) (was_online & online);
+			mask &= ((i64vector) duser >= 0) & ((i64vector) dsystem >= 0) & ((i64vector) didle >= 0);
+			mask &= ((i64vector) diowait >= 0) & ((i64vector) dsteal >= 0);
+			mask &= ((i64vector) total > 0);
+
+			// Deltas between samples are small, narrow them to 32 bits before converting to
+			// float, the 32 bit conversion is available on every SIMD instruction set.
+			mask &= ((i64vector) total < 0x7fffffff);
+			i32vector enabled = __builtin_convertvector(mask,i32vector);
+
+			f32vector scale = 1.0f / __builtin_convertvector(__builtin_convertvector(total,i32vector),f32vector);
+
+			store(user,ix,enabled ? fraction(duser,scale) : zero);
+			store(system,ix,enabled ? fraction(dsystem,scale) : zero);
+			store(iowait,ix,enabled ? fraction(diowait,scale) : zero);
+			store(steal,ix,enabled ? fraction(dsteal,scale) : zero);
+			store(busy,ix,enabled ? fraction(total - didle,scale) : zero);
+
+			for(size_t lane = 0; lane < lanes; lane++) {
+				valid[ix+lane] = (enabled[lane] != 0);
+			}
+
+		}
+
+	}
+
+ }
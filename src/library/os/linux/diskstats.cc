@@ -28,6 +28,11 @@
  #include <unistd.h>
  #include <linux/major.h>
  #include <udjat/tools/logger.h>
+ #include <private/source.h>
+ #include <private/scanner.h>
+ #include <udjat/tools/system/root.h>
+ #include <mutex>
+ #include <unordered_map>
 
  using namespace std;
 
@@ -73,33 +78,7 @@
 			st.device.assign(string{from,((size_t) (ptr-from)) - 1});
 		}
 
-
-		auto sz = sscanf(
-			ptr,
-			"%lu %lu %lu %u %lu %lu %lu %u %u %u %u %lu %lu %lu %lu",
-			&st.read.count,
-			&st.read.merged,
-			&st.read.blocks,
-			&st.read.time,
-
-			&st.write.count,
-			&st.write.merged,
-			&st.write.blocks,
-			&st.write.time,
-
-			&st.io.inprogress,
-			&st.io.time,
-			&st.io.weighted,
-
-			&st.discards.count,
-			&st.discards.merged,
-			&st.discards.blocks,
-			&st.discards.time
-		);
-
-		if(sz != 15) {
-			throw system_error(EINVAL, system_category(),"Unexpected format in /proc/diskstats");
-		}
+		st.load(ptr);
 
 	}
 
@@ -110,7 +89,7 @@
 		// https://www.kernel.org/doc/Documentation/iostats.txt
 		// https://mirrors.mit.edu/kernel/linux/docs/lanana/device-list/devices-2.6.txt
 
-		File::Text{"/proc/diskstats"}.for_each([&stats](const std::string &line){
+		File::Text{System::Root::path("/proc/diskstats").c_str()}.for_each([&stats](const std::string &line){
 
 			if(!line.empty()) {
 				Stat st;
@@ -130,34 +109,72 @@
 			throw system_error(EINVAL, system_category(),"Invalid disk name");
 		}
 
+		System::Source source{String{"/sys/block/",name(),"/stat"}.c_str()};
+		load(source.read());
+
+	}
+
+	void Storage::Stat::load(const char *contents) {
+
 		// https://www.kernel.org/doc/Documentation/block/stat.txt
-		File::Text proc{String{"/sys/block/",name(),"/stat"}.c_str()};
-
-		auto sz = sscanf(
-			next(proc.c_str()),
-			"%lu %lu %lu %u %lu %lu %lu %u %u %u %u %lu %lu %lu %lu",
-			&read.count,		// read I/Os       requests      number of read I/Os processed
-			&read.merged,		// read merges     requests      number of read I/Os merged with in-queue I/O
-			&read.blocks,		// read sectors    sectors       number of sectors read
-			&read.time,			// read ticks      milliseconds  total wait time for read requests
-
-			&write.count,		// write I/Os      requests      number of write I/Os processed
-			&write.merged,		// write merges    requests      number of write I/Os merged with in-queue I/O
-			&write.blocks,		// write sectors   sectors       number of sectors written
-			&write.time,		// write ticks     milliseconds  total wait time for write requests
-
-			&io.inprogress,		// in_flight       requests      number of I/Os currently in flight
-			&io.time,			// io_ticks        milliseconds  total time this block device has been active
-			&io.weighted,		// time_in_queue   milliseconds  total wait time for all requests
-
-			&discards.count,	// discard I/Os    requests      number of discard I/Os processed
-			&discards.merged,	// discard merges  requests      number of discard I/Os merged with in-queue I/O
-			&discards.blocks,	// discard sectors sectors       number of sectors discarded
-			&discards.time		// discard ticks   milliseconds  total wait time for discard requests
-		);
-
-		if(sz != 15) {
-			throw system_error(EINVAL, system_category(),String{"Unexpected format in /sys/block/",name(),"/stat"});
+		//
+		// Kernels before 4.18 have 11 fields, 4.18 added the discard fields (15)
+		// and 5.5 added the flush fields (17).
+		//
+		struct Field {
+			unsigned long *ul;
+			unsigned int *ui;
+		};
+
+		static const size_t minimal = 11;
+
+		const Field fields[] = {
+			{ &read.count, nullptr },		// read I/Os       requests      number of read I/Os processed
+			{ &read.merged, nullptr },		// read merges     requests      number of read I/Os merged with in-queue I/O
+			{ &read.blocks, nullptr },		// read sectors    sectors       number of sectors read
+			{ nullptr, &read.time },		// read ticks      milliseconds  total wait time for read requests
+
+			{ &write.count, nullptr },		// write I/Os      requests      number of write I/Os processed
+			{ &write.merged, nullptr },		// write merges    requests      number of write I/Os merged with in-queue I/O
+			{ &write.blocks, nullptr },		// write sectors   sectors       number of sectors written
+			{ nullptr, &write.time },		// write ticks     milliseconds  total wait time for write requests
+
+			{ nullptr, &io.inprogress },	// in_flight       requests      number of I/Os currently in flight
+			{ nullptr, &io.time },			// io_ticks        milliseconds  total time this block device has been active
+			{ nullptr, &io.weighted },		// time_in_queue   milliseconds  total wait time for all requests
+
+			{ &discards.count, nullptr },	// discard I/Os    requests      number of discard I/Os processed
+			{ &discards.merged, nullptr },	// discard merges  requests      number of discard I/Os merged with in-queue I/O
+			{ &discards.blocks, nullptr },	// discard sectors sectors       number of sectors discarded
+			{ &discards.time, nullptr },	// discard ticks   milliseconds  total wait time for discard requests
+
+			{ &flush.count, nullptr },		// flush I/Os      requests      number of flush I/Os processed
+			{ &flush.time, nullptr },		// flush ticks     milliseconds  total wait time for flush requests
+		};
+
+		size_t count = 0;
+		for(const auto &field : fields) {
+
+			unsigned long long value;
+			if(!Scanner::number(contents,value)) {
+				break;
+			}
+
+			if(field.ul) {
+				*field.ul = (unsigned long) value;
+			} else {
+				*field.ui = (unsigned int) value;
+			}
+
+			count++;
+
+		}
+
+		if(count < minimal) {
+			if(device.empty()) {
+				throw system_error(EINVAL, system_category(),"Unexpected format in block device stat");
+			}
+			throw system_error(EINVAL, system_category(),String{"Unexpected format in block device stat for '",name(),"'"});
 		}
 
 	}
@@ -170,7 +187,7 @@
 
 		} else {
 
-			File::Text{"/proc/diskstats"}.for_each([&](const std::string &line){
+			File::Text{System::Root::path("/proc/diskstats").c_str()}.for_each([&](const std::string &line){
 
 				if(!line.empty()) {
 					Stat st;
@@ -210,12 +227,15 @@
 		discards.blocks += s.discards.blocks;
 		discards.time += s.discards.time;
 
+		flush.count += s.flush.count;
+		flush.time += s.flush.time;
+
 		return *this;
 	}
 
 	bool Storage::Stat::physical() const {
 
-		File::Path path{String{"/sys/block/",device.c_str()}.c_str()};
+		File::Path path{System::Root::path(String{"/sys/block/",device.c_str()}.c_str()).c_str()};
 		if(access(path.c_str(),F_OK)) {
 			// No block device, return false.
 			return false;
@@ -233,32 +253,119 @@
 		return true;
 	}
 
+	/// @brief Get logical block size from sysfs.
+	/// @return The block size or zero if not available.
+	static size_t sysfs_blocksize(const char *path) noexcept {
+
+		try {
+
+			if(access(path,R_OK)) {
+				return 0;
+			}
+
+			char buffer[32];
+			System::Source source{path,sizeof(buffer)};
+			source.read(buffer,sizeof(buffer));
+
+			const char *ptr = buffer;
+			size_t value = 0;
+			if(Scanner::number(ptr,value)) {
+				return value;
+			}
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Cant get block size from '",path,"': ",e.what()}.warning();
+
+		}
+
+		return 0;
+
+	}
+
+	/// @brief Process-wide block size cache, keyed by major:minor.
+	static struct {
+		std::mutex guard;
+		unsigned int generation = 0;
+		std::unordered_map<uint32_t,size_t> sizes;
+	} cache;
+
+	void Storage::Stat::forget(unsigned int major, unsigned int minor) noexcept {
+		std::lock_guard<std::mutex> lock(cache.guard);
+		cache.sizes.erase((((uint32_t) major) << 20) | ((uint32_t) minor));
+	}
+
 	size_t Storage::Stat::blocksize() const {
 
-		// Reference:
-		// https://stackoverflow.com/questions/40068904/portable-way-to-determine-sector-size-in-linux
+		uint32_t key = (((uint32_t) major) << 20) | ((uint32_t) minor);
 
-#ifdef BLKSSZGET
+		if(key) {
+			std::lock_guard<std::mutex> lock(cache.guard);
+
+			// A new root has other devices.
+			unsigned int current = System::Root::generation();
+			if(cache.generation != current) {
+				cache.generation = current;
+				cache.sizes.clear();
+			}
 
-		int fd = open(String{"/dev/",device.c_str()}.c_str(),O_RDONLY);
-		if(fd < 0) {
-			throw system_error(errno, system_category(),String{"Cant open '/dev/",name(),"'"});
+			auto entry = cache.sizes.find(key);
+			if(entry != cache.sizes.end()) {
+				return entry->second;
+			}
 		}
+
 		size_t blockSize = 0;
-		if(ioctl(fd, BLKSSZGET, &blockSize)) {
-			int rc = errno;
-			close(fd);
-			throw system_error(rc, system_category(),String{"Cant get '/dev/",name(),"' block size"});
+
+		// https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-block
+		if(!device.empty()) {
+			blockSize = sysfs_blocksize(System::Root::path(String{"/sys/block/",device.c_str(),"/queue/logical_block_size"}.c_str()).c_str());
 		}
-		close(fd);
 
-		return blockSize;
+		if(!blockSize && key) {
+			// Not a whole disk (partition?), try the device node from major:minor and its parent.
+			blockSize = sysfs_blocksize(System::Root::path(String{"/sys/dev/block/",major,":",minor,"/queue/logical_block_size"}.c_str()).c_str());
+			if(!blockSize) {
+				blockSize = sysfs_blocksize(System::Root::path(String{"/sys/dev/block/",major,":",minor,"/../queue/logical_block_size"}.c_str()).c_str());
+			}
+		}
+
+		if(!blockSize) {
+
+			// No sysfs information, ask the device.
+			// Reference:
+			// https://stackoverflow.com/questions/40068904/portable-way-to-determine-sector-size-in-linux
+
+#ifdef BLKSSZGET
+
+			int fd = open(String{"/dev/",device.c_str()}.c_str(),O_RDONLY|O_CLOEXEC);
+			if(fd < 0) {
+				throw system_error(errno, system_category(),String{"Cant open '/dev/",name(),"'"});
+			}
+			int size = 0;
+			if(ioctl(fd, BLKSSZGET, &size)) {
+				int rc = errno;
+				close(fd);
+				throw system_error(rc, system_category(),String{"Cant get '/dev/",name(),"' block size"});
+			}
+			close(fd);
+
+			blockSize = (size_t) size;
 #else
 
-		return 512;
+			blockSize = sector_size;
 
 #endif // BLKSSZGET
 
+		}
+
+		if(key) {
+			std::lock_guard<std::mutex> lock(cache.guard);
+			cache.sizes[key] = blockSize;
+		}
+
+		return blockSize;
+
 	}
 
  }
@@ -0,0 +1,313 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/historyfile.h>
+ #include <private/source.h>
+ #include <system_error>
+ #include <cstdlib>
+ #include <cstring>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "history"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static const char signature[8] = { 'U', 'D', 'J', 'A', 'T', 'H', 'S', 'T' };
+
+	static inline uint64_t align(uint64_t value) noexcept {
+		return (value + 7) & ~((uint64_t) 7);
+	}
+
+	/// @brief Get the kernel boot id.
+	static void get_boot_id(char *buffer, size_t length) {
+
+		memset(buffer,0,length);
+
+		try {
+
+			System::Source source{"/proc/sys/kernel/random/boot_id",64};
+			const char *ptr = source.read();
+
+			size_t ix = 0;
+			while(ix < (length-1) && ptr[ix] && ptr[ix] != '\n') {
+				buffer[ix] = ptr[ix];
+				ix++;
+			}
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Can't get boot id: ",e.what()}.warning();
+
+		}
+
+	}
+
+	System::HistoryFile & System::HistoryFile::getInstance() {
+		static HistoryFile instance;
+		return instance;
+	}
+
+	System::HistoryFile::~HistoryFile() {
+
+		Timer::disable();
+
+		if(map) {
+			sync();
+			munmap(map,header().size);
+			map = nullptr;
+		}
+
+		if(fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+
+	}
+
+	void System::HistoryFile::format(size_t size, uint32_t capacity, const char *boot_id) noexcept {
+
+		memset(map,0,sizeof(Header) + (sizeof(Entry) * capacity));
+
+		Header &hdr = header();
+		memcpy(hdr.magic,signature,sizeof(hdr.magic));
+		hdr.version = version;
+		hdr.entries = 0;
+		hdr.capacity = capacity;
+		hdr.size = size;
+		hdr.used = align(sizeof(Header) + (sizeof(Entry) * capacity));
+		strncpy(hdr.boot_id,boot_id,sizeof(hdr.boot_id)-1);
+
+	}
+
+	void System::HistoryFile::open(const char *path, size_t size, uint32_t capacity, unsigned long interval) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(map) {
+			if(filename == path) {
+				return;
+			}
+			throw system_error(EBUSY,system_category(),string{"History file is already open as '"} + filename + "'");
+		}
+
+		size_t minimal = align(sizeof(Header) + (sizeof(Entry) * capacity)) + 4096;
+		if(size < minimal) {
+			size = minimal;
+		}
+
+		fd = ::open(path,O_RDWR|O_CREAT|O_CLOEXEC,0640);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),string{"Can't open '"} + path + "'");
+		}
+
+		struct stat st;
+		if(fstat(fd,&st)) {
+			int err = errno;
+			::close(fd);
+			fd = -1;
+			throw system_error(err,system_category(),string{"Can't stat '"} + path + "'");
+		}
+
+		// Keep the size of an existing file, the layout depends on it.
+		bool empty = (st.st_size < (off_t) sizeof(Header));
+		if(!empty) {
+			size = (size_t) st.st_size;
+		} else if(ftruncate(fd,(off_t) size)) {
+			int err = errno;
+			::close(fd);
+			fd = -1;
+			throw system_error(err,system_category(),string{"Can't resize '"} + path + "'");
+		}
+
+		void *ptr = mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+		if(ptr == MAP_FAILED) {
+			int err = errno;
+			::close(fd);
+			fd = -1;
+			throw system_error(err,system_category(),string{"Can't map '"} + path + "'");
+		}
+
+		map = (uint8_t *) ptr;
+		filename = path;
+
+		char boot_id[sizeof(Header::boot_id)];
+		get_boot_id(boot_id,sizeof(boot_id));
+
+		Header &hdr = header();
+
+		if(empty || memcmp(hdr.magic,signature,sizeof(hdr.magic)) || hdr.version != version || hdr.size != size
+				|| hdr.used > size || hdr.entries > hdr.capacity
+				|| (sizeof(Header) + (sizeof(Entry) * hdr.capacity)) > hdr.used) {
+
+			if(!empty) {
+				Logger::String{"Unexpected layout on '",path,"', resetting history"}.warning();
+			}
+
+			format(size,capacity,boot_id);
+
+		} else if(strncmp(hdr.boot_id,boot_id,sizeof(hdr.boot_id))) {
+
+			// The system was restarted, the saved counters are no longer valid.
+			Logger::String{"System was restarted, resetting counters on '",path,"'"}.trace();
+
+			Entry *entries = directory();
+			for(uint32_t ix = 0; ix < hdr.entries; ix++) {
+				if(entries[ix].offset + sizeof(History::Segment) <= size) {
+					((History::Segment *) (map + entries[ix].offset))->flags &= ~History::BaselineValid;
+				}
+			}
+
+			memset(hdr.boot_id,0,sizeof(hdr.boot_id));
+			strncpy(hdr.boot_id,boot_id,sizeof(hdr.boot_id)-1);
+
+		} else {
+
+			Logger::String{"Using ",hdr.entries," histories from '",path,"'"}.trace();
+
+		}
+
+		Timer::set(interval);
+		Timer::enable();
+
+	}
+
+	bool System::HistoryFile::open(const XML::Node &node) {
+
+		if(map) {
+			return true;
+		}
+
+		const char *dir = node.attribute("state-dir").as_string("");
+		if(!*dir) {
+			dir = getenv("UDJAT_STATE_DIR");
+		}
+
+		if(!(dir && *dir)) {
+			return false;
+		}
+
+		try {
+
+			mkdir(dir,0750);
+			open(
+				(string{dir} + "/" + PACKAGE_NAME + ".history").c_str(),
+				node.attribute("history-file-size").as_uint(16) * 1048576,
+				1024,
+				node.attribute("history-sync").as_uint(60) * 1000
+			);
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Persistent history is disabled: ",e.what()}.error();
+
+		}
+
+		return map != nullptr;
+
+	}
+
+	System::History::Segment * System::HistoryFile::get(const char *name, size_t depth) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(!map || !depth) {
+			return nullptr;
+		}
+
+		Header &hdr = header();
+		Entry *entries = directory();
+
+		uint64_t length = align(sizeof(History::Segment) + (depth * sizeof(int64_t)) + (depth * sizeof(float)));
+
+		Entry *entry = nullptr;
+		for(uint32_t ix = 0; ix < hdr.entries; ix++) {
+			if(!strncmp(entries[ix].name,name,sizeof(entries[ix].name))) {
+				entry = entries+ix;
+				break;
+			}
+		}
+
+		if(entry && entry->depth == depth && (entry->offset + length) <= hdr.size) {
+
+			History::Segment *segment = (History::Segment *) (map + entry->offset);
+
+			if(segment->depth != depth || segment->head >= depth || segment->count > depth) {
+				// Inconsistent segment, reset it.
+				memset(segment,0,sizeof(History::Segment));
+				segment->depth = (uint32_t) depth;
+			}
+
+			return segment;
+
+		}
+
+		if(!entry) {
+
+			if(hdr.entries >= hdr.capacity) {
+				Logger::String{"History directory is full, '",name,"' will not be persistent"}.warning();
+				return nullptr;
+			}
+
+			entry = entries + hdr.entries;
+			memset(entry,0,sizeof(Entry));
+			strncpy(entry->name,name,sizeof(entry->name)-1);
+			hdr.entries++;
+
+		}
+
+		// New segment (or new depth, the old space is not reused).
+		if(hdr.used + length > hdr.size) {
+			Logger::String{"History file is full, '",name,"' will not be persistent"}.warning();
+			return nullptr;
+		}
+
+		History::Segment *segment = (History::Segment *) (map + hdr.used);
+		memset(segment,0,length);
+		segment->depth = (uint32_t) depth;
+
+		entry->offset = hdr.used;
+		entry->depth = (uint32_t) depth;
+		hdr.used += length;
+
+		return segment;
+
+	}
+
+	void System::HistoryFile::sync() noexcept {
+		if(map && msync(map,header().size,MS_ASYNC)) {
+			Logger::String{"Error syncing '",filename.c_str(),"': ",strerror(errno)}.error();
+		}
+	}
+
+	void System::HistoryFile::on_timer() {
+		sync();
+	}
+
+ }
@@ -0,0 +1,200 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Block device hotplug from kernel uevents.
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/handler.h>
+ #include <udjat/tools/storage/stat.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/storagecontroller.h>
+ #include <system_error>
+ #include <cstring>
+ #include <cstdlib>
+ #include <unistd.h>
+ #include <sys/socket.h>
+ #include <linux/netlink.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "storage"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief NETLINK_KOBJECT_UEVENT listener, adds and removes disks from the controller.
+	class Storage::Controller::Monitor : public MainLoop::Handler {
+	private:
+
+		Controller &controller;
+
+		/// @brief Handle one uevent message.
+		void parse(const char *message, size_t length) {
+
+			// "ACTION@DEVPATH\0KEY=VALUE\0KEY=VALUE\0..."
+			const char *action = nullptr;
+			const char *subsystem = nullptr;
+			const char *devtype = nullptr;
+			const char *devname = nullptr;
+			unsigned int major = 0, minor = 0;
+
+			for(size_t offset = strlen(message)+1; offset < length; offset += strlen(message+offset)+1) {
+
+				const char *field = message+offset;
+
+				if(!strncmp(field,"ACTION=",7)) {
+					action = field+7;
+				} else if(!strncmp(field,"SUBSYSTEM=",10)) {
+					subsystem = field+10;
+				} else if(!strncmp(field,"DEVTYPE=",8)) {
+					devtype = field+8;
+				} else if(!strncmp(field,"DEVNAME=",8)) {
+					devname = field+8;
+				} else if(!strncmp(field,"MAJOR=",6)) {
+					major = (unsigned int) atoi(field+6);
+				} else if(!strncmp(field,"MINOR=",6)) {
+					minor = (unsigned int) atoi(field+6);
+				}
+
+			}
+
+			// Only whole disks, partitions are not watched.
+			if(!(action && subsystem && devtype && devname) || strcmp(subsystem,"block") || strcmp(devtype,"disk")) {
+				return;
+			}
+
+			if(!strcmp(action,"add")) {
+
+				Storage::Stat stat{devname};
+				if(stat.physical()) {
+					stat.major = major;
+					stat.minor = minor;
+					controller.push_back(stat);
+				}
+
+			} else if(!strcmp(action,"remove")) {
+
+				controller.remove(major,minor);
+
+			}
+
+		}
+
+	protected:
+
+		void handle_event(const Event event) override {
+
+			if(event & (onerror|onhangup)) {
+				Logger::String{"Error on hotplug monitor, disabling it"}.error();
+				disable();
+				return;
+			}
+
+			char buffer[8192];
+
+			while(true) {
+
+				ssize_t bytes = recv(fd,buffer,sizeof(buffer)-1,MSG_DONTWAIT);
+
+				if(bytes < 0) {
+					if(errno == EINTR) {
+						continue;
+					}
+					if(errno == ENOBUFS) {
+						// Events were lost, rescan now.
+						Logger::String{"Hotplug events lost, rescanning disks"}.warning();
+						controller.reconcile();
+						continue;
+					}
+					break;
+				}
+
+				if(bytes == 0) {
+					break;
+				}
+
+				buffer[bytes] = 0;
+
+				try {
+
+					parse(buffer,(size_t) bytes);
+
+				} catch(const std::exception &e) {
+
+					Logger::String{"Error handling hotplug event: ",e.what()}.error();
+
+				}
+
+			}
+
+		}
+
+	public:
+
+		Monitor(Controller &c) : MainLoop::Handler{-1,oninput}, controller{c} {
+
+			int sock = socket(AF_NETLINK,SOCK_DGRAM|SOCK_CLOEXEC|SOCK_NONBLOCK,NETLINK_KOBJECT_UEVENT);
+			if(sock < 0) {
+				throw system_error(errno,system_category(),"Can't open uevent socket");
+			}
+
+			struct sockaddr_nl addr;
+			memset(&addr,0,sizeof(addr));
+			addr.nl_family = AF_NETLINK;
+			addr.nl_pid = 0;
+			addr.nl_groups = 1;		// Kernel events.
+
+			if(bind(sock,(struct sockaddr *) &addr,sizeof(addr))) {
+				int err = errno;
+				::close(sock);
+				throw system_error(err,system_category(),"Can't bind uevent socket");
+			}
+
+			MainLoop::Handler::set(sock);
+			MainLoop::Handler::enable();
+
+			Logger::String{"Watching block device hotplug events"}.trace();
+
+		}
+
+		virtual ~Monitor() {
+			MainLoop::Handler::disable();
+			if(fd >= 0) {
+				::close(fd);
+				fd = -1;
+			}
+		}
+
+	};
+
+	std::shared_ptr<Storage::Controller::Monitor> Storage::Controller::MonitorFactory() {
+
+		if(!System::Root::path("").empty()) {
+			throw system_error(ENOTSUP,system_category(),"Not available with a custom system root");
+		}
+
+		return std::make_shared<Monitor>(*this);
+
+	}
+
+ }
@@ -0,0 +1,376 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/limits.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/string.h>
+ #include <private/source.h>
+ #include <private/keyedparser.h>
+ #include <private/scanner.h>
+ #include <system_error>
+ #include <sys/inotify.h>
+ #include <sched.h>
+ #include <unistd.h>
+ #include <cstring>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "limits"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Read a cgroup file, false if it's not available.
+	static bool read(const std::string &filename, char *buffer, size_t length) noexcept {
+
+		*buffer = 0;
+
+		if(access(System::Root::path(filename.c_str()).c_str(),R_OK)) {
+			return false;
+		}
+
+		try {
+
+			System::Source source{filename.c_str(),length};
+			source.read(buffer,length);
+
+		} catch(const std::exception &) {
+
+			*buffer = 0;
+			return false;
+
+		}
+
+		return true;
+
+	}
+
+	/// @brief Get the number of cpus in the affinity mask of the current process.
+	static unsigned int cpucount() noexcept {
+
+		// The mask should be large enough for the kernel's nr_cpu_ids.
+		for(size_t cpus = 1024; cpus <= 65536; cpus *= 2) {
+
+			cpu_set_t *set = CPU_ALLOC(cpus);
+			if(!set) {
+				break;
+			}
+
+			size_t size = CPU_ALLOC_SIZE(cpus);
+			CPU_ZERO_S(size,set);
+
+			if(sched_getaffinity(0,size,set) == 0) {
+				unsigned int rc = (unsigned int) CPU_COUNT_S(size,set);
+				CPU_FREE(set);
+				return rc;
+			}
+
+			int err = errno;
+			CPU_FREE(set);
+
+			if(err != EINVAL) {
+				break;
+			}
+
+		}
+
+		return 0;
+
+	}
+
+	System::Limits & System::Limits::getInstance() {
+		static Limits instance;
+		return instance;
+	}
+
+	System::Limits::Limits() : MainLoop::Handler{-1,MainLoop::Handler::oninput} {
+	}
+
+	std::string System::Limits::detect() {
+
+		// https://docs.kernel.org/admin-guide/cgroup-v2.html
+		// /proc/self/cgroup, the unified hierarchy is the '0::' line.
+		System::Source cgroup{"/proc/self/cgroup"};
+		for(const char *ptr = cgroup.read(); *ptr; ptr = Scanner::eol(ptr)) {
+			if(!strncmp(ptr,"0::/",4)) {
+				const char *from = ptr+4;
+				const char *to = from;
+				while(*to && *to != '\n') {
+					to++;
+				}
+				return std::string{from,(size_t) (to-from)};
+			}
+		}
+
+		return "";
+
+	}
+
+	System::Limits::~Limits() {
+		MainLoop::Handler::disable();
+		if(fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+	}
+
+	void System::Limits::watch(const std::string &filename) {
+
+		if(fd < 0) {
+			return;
+		}
+
+		// Writes to the cgroup interface files are reported as IN_MODIFY.
+		int wd = inotify_add_watch(fd,Root::path(filename.c_str()).c_str(),IN_MODIFY|IN_DELETE_SELF);
+		if(wd >= 0) {
+			watches.push_back(wd);
+		}
+
+	}
+
+	void System::Limits::handle_event(const Event event) {
+
+		if(event & (onerror|onhangup)) {
+			Logger::String{"Error on inotify descriptor, the limits will not be updated"}.error();
+			MainLoop::Handler::disable();
+			return;
+		}
+
+		// Drain the events, any change reloads all limits.
+		char buffer[4096];
+		while(::read(fd,buffer,sizeof(buffer)) > 0);
+
+		try {
+
+			std::lock_guard<std::recursive_mutex> lock(guard);
+			load();
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error reloading limits: ",e.what()}.error();
+
+		}
+
+	}
+
+	void System::Limits::check() {
+
+		if(!generation || generation != Root::generation()) {
+			load();
+			return;
+		}
+
+		// The inotify watches are on the limit files, a move to another cgroup is
+		// not reported; check it on a slow interval.
+		unsigned long long now = Root::now();
+		if(now >= (verified + 60000)) {
+			verified = now;
+			if(detect() != path) {
+				Logger::String{"The process was moved to another cgroup, reloading limits"}.trace();
+				load();
+			}
+		}
+
+	}
+
+	void System::Limits::load() {
+
+		generation = Root::generation();
+		verified = Root::now();
+
+		for(int wd : watches) {
+			inotify_rm_watch(fd,wd);
+		}
+		watches.clear();
+
+		if(fd < 0) {
+			fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+			if(fd < 0) {
+				Logger::String{"Can't watch the cgroup limits: ",strerror(errno)}.warning();
+			} else {
+				MainLoop::Handler::enable();
+			}
+		}
+
+		path = detect();
+
+		// Keep the usage files open, memused() is called on every agent update. The path
+		// is empty on a private cgroup namespace (docker, podman) too, memory.current is
+		// absent only on the host root cgroup.
+		usage.current.reset();
+		usage.stat.reset();
+		{
+			std::string prefix{"/sys/fs/cgroup"};
+			if(!path.empty()) {
+				prefix += "/";
+				prefix += path;
+			}
+			if(!access(Root::path((prefix + "/memory.current").c_str()).c_str(),R_OK)) {
+				usage.current.reset(new System::Source{(prefix + "/memory.current").c_str(),64});
+				usage.stat.reset(new System::Source{(prefix + "/memory.stat").c_str()});
+			}
+		}
+
+		// Not affected by System::Root, the affinity is always from the current process.
+		affinity = cpucount();
+		cpus = (float) affinity;
+		memory = 0;
+
+		// The limits of every ancestor apply, the effective one is the smallest.
+		std::string dirname{path};
+		while(true) {
+
+			std::string prefix{"/sys/fs/cgroup/"};
+			if(!dirname.empty()) {
+				prefix += dirname;
+				prefix += "/";
+			}
+
+			char buffer[64];
+
+			// cpu.max: "$MAX $PERIOD", $MAX is 'max' for no limit (not available on the root cgroup).
+			if(read(prefix + "cpu.max",buffer,sizeof(buffer))) {
+
+				const char *ptr = buffer;
+				unsigned long long quota, period;
+				if(Scanner::number(ptr,quota) && Scanner::number(ptr,period) && period) {
+					float value = ((float) quota) / ((float) period);
+					if(!cpus || value < cpus) {
+						cpus = value;
+					}
+				}
+
+				watch(prefix + "cpu.max");
+
+			}
+
+			// memory.max and memory.high: bytes or 'max'.
+			for(const char *name : { "memory.max", "memory.high" }) {
+
+				if(read(prefix + name,buffer,sizeof(buffer))) {
+
+					const char *ptr = buffer;
+					unsigned long long value;
+					if(Scanner::number(ptr,value) && (!memory || value < memory)) {
+						memory = value;
+					}
+
+					watch(prefix + name);
+
+				}
+
+			}
+
+			if(dirname.empty()) {
+				break;
+			}
+
+			size_t pos = dirname.rfind('/');
+			if(pos == string::npos) {
+				dirname.clear();
+			} else {
+				dirname.resize(pos);
+			}
+
+		}
+
+		Logger::String{
+			"cgroup '/",path.c_str(),"', ",affinity," cpu(s) on affinity mask, effective cpus: ",cpus,
+			", memory limit: ",(memory ? std::to_string(memory).c_str() : "none")
+		}.trace();
+
+	}
+
+	std::string System::Limits::cgroup() {
+		std::lock_guard<std::recursive_mutex> lock(guard);
+		check();
+		return path;
+	}
+
+	float System::Limits::cores(float total) {
+		std::lock_guard<std::recursive_mutex> lock(guard);
+		check();
+		if(cpus > 0 && cpus < total) {
+			return cpus;
+		}
+		return total;
+	}
+
+	unsigned long long System::Limits::memtotal(unsigned long long total) {
+		std::lock_guard<std::recursive_mutex> lock(guard);
+		check();
+		if(memory && memory < total) {
+			return memory;
+		}
+		return total;
+	}
+
+	unsigned long long System::Limits::memused() {
+
+		std::lock_guard<std::recursive_mutex> lock(guard);
+		check();
+
+		// Not available on the host root cgroup.
+		if(!usage.current) {
+			return 0;
+		}
+
+		unsigned long long current;
+
+		try {
+
+			const char *ptr = usage.current->read();
+			if(!Scanner::number(ptr,current)) {
+				return 0;
+			}
+
+		} catch(const std::exception &) {
+
+			// The cgroup was removed (the process was moved), detect it again on the next call.
+			generation = 0;
+			return 0;
+
+		}
+
+		// The working set, same as the container runtimes: the inactive file cache can be
+		// reclaimed without pressure.
+		try {
+
+			static const KeyedParser parser{"inactive_file"};
+			unsigned long long inactive;
+
+			parser.parse(usage.stat->read(),&inactive);
+
+			if(inactive < current) {
+				current -= inactive;
+			}
+
+		} catch(const std::exception &) {
+		}
+
+		return current;
+
+	}
+
+ }
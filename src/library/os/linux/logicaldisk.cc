@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/logicaldisk.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/mounttable.h>
+ #include <system_error>
+ #include <stdexcept>
+ #include <cstring>
+ #include <memory>
+ #include <sys/statvfs.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Abstract::Agent> Disk::Logical::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<Logical>(node);
+	}
+
+	String Disk::Logical::NameFactory(const char * devname, bool required) {
+
+		if(!(devname && *devname)) {
+			if(required) {
+				throw runtime_error("A device name is required");
+			}
+			return "";
+		}
+
+		// Without trailing slashes, the root filesystem ('/') is 'root'.
+		std::string path{devname};
+		while(!path.empty() && path.back() == '/') {
+			path.pop_back();
+		}
+
+		if(path.empty()) {
+			return "root";
+		}
+
+		size_t pos = path.rfind('/');
+		String result{(pos == std::string::npos) ? path.c_str() : (path.c_str()+pos+1)};
+
+		if(required && result.empty()) {
+			throw runtime_error("Invalid device name");
+		}
+
+		return result;
+
+	}
+
+	String Disk::Logical::DeviceNameFactory(const char * devname, bool required) {
+
+		if(!(devname && *devname)) {
+			if(required) {
+				throw runtime_error("A device name is required");
+			}
+			return "";
+		}
+
+		// Mount points and device paths are used as is.
+		if(*devname == '/') {
+			return String{devname};
+		}
+
+		return String{"/dev/",devname};
+
+	}
+
+	String Disk::Logical::DeviceNameFactory(const XML::Node &node, bool required) {
+
+		String devname{node,"device-name"};
+		if(!devname.empty()) {
+			return DeviceNameFactory(devname.c_str(),required);
+		}
+
+		devname = String{node,"mount-point"};
+		if(!devname.empty()) {
+			return DeviceNameFactory(devname.c_str(),required);
+		}
+
+		return DeviceNameFactory(String{node,"name"}.c_str(),required);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	Disk::Logical::Logical(const char *name) : Agent<Percentage>{NameFactory(name).c_str()}, devname{DeviceNameFactory(name)} {
+		Object::properties.icon = "drive-harddisk";
+		Object::properties.label = _( "Disk usage" );
+	}
+
+	Disk::Logical::Logical(const pugi::xml_node &node) : Agent<Percentage>{node}, devname{DeviceNameFactory(node)} {
+
+		if(is_empty(Object::properties.icon)) {
+			Object::properties.icon = "drive-harddisk";
+		}
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = _( "Disk usage" );
+		}
+
+	}
+
+	Disk::Logical::Logical(const char *name, const pugi::xml_node &node) : Agent<Percentage>{node}, devname{DeviceNameFactory(name)} {
+
+		if(is_empty(Object::properties.icon)) {
+			Object::properties.icon = "drive-harddisk";
+		}
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = _( "Disk usage" );
+		}
+
+	}
+
+	Disk::Logical::~Logical() {
+	}
+
+	bool Disk::Logical::refresh() {
+
+		// No mount table scan, it's parsed again only after changes.
+		System::MountTable::Entry entry;
+		if(!System::MountTable::getInstance().find(devname.c_str(),entry)) {
+			throw system_error(ENOENT,system_category(),String{"'",devname.c_str(),"' is not mounted"});
+		}
+
+		struct statvfs st;
+		if(statvfs(System::Root::path(entry.mountpoint.c_str()).c_str(),&st)) {
+			throw system_error(errno,system_category(),String{"Can't get usage of '",entry.mountpoint.c_str(),"'"});
+		}
+
+		unsigned long long fragment = (unsigned long long) (st.f_frsize ? st.f_frsize : st.f_bsize);
+
+		usage.mountpoint = entry.mountpoint;
+		usage.device = entry.device;
+		usage.fstype = entry.fstype;
+		usage.total = ((unsigned long long) st.f_blocks) * fragment;
+		usage.available = ((unsigned long long) st.f_bavail) * fragment;
+		usage.free = ((unsigned long long) st.f_bfree) * fragment;
+
+		if(st.f_files) {
+			usage.inodes = ((float) (st.f_files - st.f_ffree)) / ((float) st.f_files);
+		} else {
+			usage.inodes = 0;
+		}
+
+		// Same as df, the reserved blocks are not available.
+		unsigned long long used = ((unsigned long long) (st.f_blocks - st.f_bfree));
+		unsigned long long size = used + ((unsigned long long) st.f_bavail);
+
+		return set(size ? ((float) used) / ((float) size) : 0);
+
+	}
+
+	Udjat::Value & Disk::Logical::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		value["mountpoint"] = usage.mountpoint.c_str();
+		value["device"] = usage.device.c_str();
+		value["fstype"] = usage.fstype.c_str();
+		value["total"] = usage.total;
+		value["available"] = usage.available;
+		value["free"] = usage.free;
+		value["inodes"].setFraction(usage.inodes);
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> Disk::Logical::computeState() {
+
+		float current = (float) this->get();
+		for(auto state : states) {
+			if(state->compare(current))
+				return state;
+		}
+
+		static const struct  {
+			float value;			///< @brief State max value.
+			const char * name;		///< @brief State name.
+			Udjat::Level level;		///< @brief State level.
+			const char * summary;	///< @brief State summary.
+			const char * body;		///< @brief State description
+		} default_states[] = {
+			{
+				0.8,
+				"low",
+				Udjat::ready,
+				N_( "${value} of disk space in use" ),
+				""
+			},
+			{
+				0.9,
+				"medium",
+				Udjat::warning,
+				N_( "${value} of disk space in use" ),
+				""
+			},
+			{
+				1.01,
+				"high",
+				Udjat::error,
+				N_( "${value} of disk space in use" ),
+				""
+			}
+		};	
+
+		for(const auto &state : default_states) {
+			if(current < state.value) {
+
+				return Abstract::Agent::StateFactory(
+					state.name,
+					state.level,
+#ifdef GETTEXT_PACKAGE
+							dgettext(GETTEXT_PACKAGE,state.summary),
+							dgettext(GETTEXT_PACKAGE,state.body)
+#else
+							state.summary,
+							state.body
+#endif // GETTEXT_PACKAGE
+				);
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }
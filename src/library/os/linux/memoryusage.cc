@@ -56,10 +56,11 @@
  #include <udjat/agent.h>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/intl.h>
- #include <udjat/tools/system.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <udjat/tools/system/limits.h>
 
  #include <memory>
- #include <sys/sysinfo.h>
 
  using namespace std;
 
@@ -73,34 +74,11 @@
 	System::MemoryUsage::MemoryUsage(const char *name) : Agent<Percentage>{name} {
 	}
 
-	System::MemoryUsage::MemoryUsage(const XML::Node &node) : Agent<Percentage>{node} {
+	System::MemoryUsage::MemoryUsage(const XML::Node &node) : Agent<Percentage>{node}, history{node} {
+		container = XML::AttributeFactory(node,"container-limits").as_bool(false);
 	}
 
 	System::MemoryUsage::~MemoryUsage() {
-
-	}
-
-	static double get_scaled(const Udjat::System::Config::File::Value &v) {
-
-		// https://github.com/GNOME/libgtop/blob/master/sysdeps/linux/glibtop_private.c
-
-        const char    *ptr = v.value.c_str();
-        char          *next;
-        unsigned long long value;
-
-        value = strtoull(ptr, &next, 0);
-
-        for ( ; *next; ++next) {
-			if (*next == 'k') {
-				value *= 1024;
-				break;
-			} else if (*next == 'M') {
-				value *= 1024 * 1024;
-				break;
-			}
-        }
-
-        return (float) value;
 	}
 
 	void System::MemoryUsage::start() {
@@ -109,6 +87,18 @@
 	}
 
 	bool System::MemoryUsage::refresh() {
+
+		// Driven by the agent update timer; agents refreshed on the same tick share
+		// one snapshot.
+		auto snapshot = Sampler::getInstance().get(timer() * 500);
+
+		bool rc = update(snapshot);
+		history.push_back((float) this->get(),snapshot.time);
+
+		return rc;
+	}
+
+	bool System::MemoryUsage::update(const Snapshot &snapshot) {
 		/**
 		 * @page free-memory Determining free memory on Linux
 		 *
@@ -141,10 +131,43 @@
 		// https://github.com/GNOME/libgtop/blob/master/sysdeps/linux/mem.c
 		// https://www.thegeekdiary.com/understanding-proc-meminfo-file-analyzing-memory-utilization-in-linux/
 
-		Udjat::System::Config::File meminfo("/proc/meminfo",":");
+		double total = (double) snapshot.memtotal;
+		double available = (double) snapshot.memavailable;
 
-		auto total  = get_scaled(meminfo["MemTotal"]);
-		auto user	= total - get_scaled(meminfo["MemAvailable"]);
+		if(!total) {
+			throw system_error(ENODATA,system_category(),"Can't get total memory from /proc/meminfo");
+		}
+
+		auto user	= total - available;
+
+		if(container) {
+
+			// Inside a container the host memory is meaningless, report the cgroup
+			// working set against its limit.
+			auto &limits = Limits::getInstance();
+			double limit = (double) limits.memtotal(snapshot.memtotal);
+
+			const char *reason = nullptr;
+			if(limit < total) {
+				double used = (double) limits.memused();
+				if(used) {
+					total = limit;
+					user = (used < limit ? used : limit);
+				} else {
+					reason = "the cgroup memory usage is not available";
+				}
+			} else {
+				reason = "there's no cgroup memory limit";
+			}
+
+			if(reason && !fallback) {
+				Logger::String{"Reporting host memory, ",reason}.warning(name());
+			} else if(!reason && fallback) {
+				Logger::String{"Reporting cgroup memory against its limit"}.info(name());
+			}
+			fallback = (reason != nullptr);
+
+		}
 
 		// auto free   = get_scaled(meminfo["MemFree"]);
 		// auto shared = get_scaled(meminfo["Shmem"]);
@@ -159,6 +182,21 @@
 		return set(usage);
 	}
 
+	Udjat::Value & System::MemoryUsage::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
 	static inline bool is_empty(const char *str) noexcept {
 		return !(str && *str);
 	}
@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/mounttable.h>
+ #include <private/scanner.h>
+ #include <udjat/tools/system/root.h>
+ #include <cstring>
+ #include <poll.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "mounts"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	System::MountTable & System::MountTable::getInstance() {
+		static MountTable instance;
+		return instance;
+	}
+
+	/// @brief Get a mountinfo field, decoding the octal escapes (\040 for spaces).
+	static const char * field(const char *ptr, std::string &value) {
+
+		value.clear();
+		ptr = Scanner::blanks(ptr);
+
+		while(*ptr && *ptr != ' ' && *ptr != '\t' && *ptr != '\n') {
+			if(ptr[0] == '\\' && ptr[1] >= '0' && ptr[1] <= '7' && ptr[2] >= '0' && ptr[2] <= '7' && ptr[3] >= '0' && ptr[3] <= '7') {
+				value += (char) (((ptr[1]-'0') << 6) | ((ptr[2]-'0') << 3) | (ptr[3]-'0'));
+				ptr += 4;
+			} else {
+				value += *(ptr++);
+			}
+		}
+
+		return ptr;
+
+	}
+
+	void System::MountTable::refresh() {
+
+		// A new root reopens the source, the poll state is from the new file.
+		unsigned int current = Root::generation();
+		if(generation != current) {
+			generation = current;
+			loaded = false;
+		}
+
+		// The mount namespace signals changes with POLLPRI|POLLERR.
+		struct pollfd pfd;
+		pfd.fd = mountinfo.descriptor();
+		pfd.events = POLLPRI;
+		pfd.revents = 0;
+
+		if(loaded && poll(&pfd,1,0) >= 0 && !(pfd.revents & (POLLPRI|POLLERR))) {
+			return;
+		}
+
+		size_t count = 0;
+		std::string ignored;
+
+		for(const char *ptr = mountinfo.read(); *ptr; ptr = Scanner::eol(ptr)) {
+
+			// 36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue
+			unsigned long id, parent;
+			unsigned int major, minor;
+
+			const char *p = ptr;
+			if(!(Scanner::number(p,id) && Scanner::number(p,parent) && Scanner::number(p,major) && *p++ == ':' && Scanner::number(p,minor))) {
+				continue;
+			}
+
+			if(count == entries.size()) {
+				entries.emplace_back();
+			}
+
+			Entry &entry = entries[count];
+			entry.major = major;
+			entry.minor = minor;
+
+			p = field(p,ignored);				// Root of the mount.
+			p = field(p,entry.mountpoint);		// Mount point.
+
+			// Skip options and optional fields up to the separator.
+			const char *eol = Scanner::eol(p);
+			const char *separator = strstr(p," - ");
+			if(!separator || separator > eol) {
+				continue;
+			}
+
+			p = field(separator+3,entry.fstype);
+			field(p,entry.device);
+
+			count++;
+
+		}
+
+		// Keep the entries, the strings will be reused.
+		entries.resize(count);
+		loaded = true;
+
+		Logger::String{"Mount table loaded with ",count," entries"}.trace();
+
+	}
+
+	bool System::MountTable::find(const char *name, Entry &entry) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		refresh();
+
+		// Device name without path.
+		const char *devname = strrchr(name,'/');
+		devname = (devname && devname[1]) ? devname+1 : name;
+
+		const Entry *selected = nullptr;
+
+		for(const auto &e : entries) {
+
+			if(!strcmp(e.mountpoint.c_str(),name) || !strcmp(e.device.c_str(),name)) {
+				selected = &e;
+			} else if(!selected && *name != '/' && !strncmp(e.device.c_str(),"/dev/",5) && !strcmp(e.device.c_str()+5,devname)) {
+				selected = &e;
+			}
+
+		}
+
+		if(!selected) {
+			return false;
+		}
+
+		entry = *selected;
+		return true;
+
+	}
+
+ }
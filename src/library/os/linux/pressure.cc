@@ -0,0 +1,462 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @page psi Pressure stall information
+  *
+  * <https://docs.kernel.org/accounting/psi.html>
+  *
+  * some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+  * full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+  *
+  * The 'some' line indicates the share of time in which at least some tasks are stalled on a given
+  * resource, the 'full' line the share of time in which all non-idle tasks are stalled simultaneously.
+  *
+  * Writing "<some|full> <stall amount in us> <time window in us>" to the file registers a trigger,
+  * poll() reports POLLPRI when the stall time exceeds the threshold within the window.
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/pressure.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/handler.h>
+ #include <udjat/tools/timer.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/source.h>
+ #include <private/scanner.h>
+ #include <private/cgroupcontroller.h>
+ #include <system_error>
+ #include <memory>
+ #include <cstring>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <poll.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Kernel PSI trigger.
+	class System::Pressure::Trigger : public MainLoop::Handler, private MainLoop::Timer {
+	private:
+
+		Pressure &agent;
+
+		/// @brief The trigger window (in milliseconds).
+		unsigned long window = 0;
+
+		/// @brief Time of the last event (System::Root::now()).
+		unsigned long long fired = 0;
+
+		/// @brief Parse trigger, get window in milliseconds.
+		static unsigned long parse(const char *spec) {
+
+			// "<some|full> <stall amount in us> <time window in us>"
+			const char *ptr = Scanner::blanks(spec);
+			if(strncmp(ptr,"some ",5) && strncmp(ptr,"full ",5)) {
+				throw system_error(EINVAL,system_category(),String{"Invalid PSI trigger '",spec,"'"});
+			}
+			ptr += 5;
+
+			unsigned long long stall, window;
+			if(!(Scanner::number(ptr,stall) && Scanner::number(ptr,window)) || !window || stall > window) {
+				throw system_error(EINVAL,system_category(),String{"Invalid PSI trigger '",spec,"'"});
+			}
+
+			return (unsigned long) (window / 1000);
+
+		}
+
+		/// @brief Open pressure file, register trigger.
+		static int open(const char *filename, const char *spec) {
+
+			// A custom root or replay has copies of the pressure files: writing the spec
+			// would corrupt them and a regular file never raises POLLPRI.
+			if(!Root::path("").empty()) {
+				throw system_error(ENOTSUP,system_category(),"PSI triggers are not available with a custom system root");
+			}
+
+			std::string path = Root::path(filename);
+
+			int fd = ::open(path.c_str(),O_RDWR|O_NONBLOCK|O_CLOEXEC);
+			if(fd < 0) {
+				throw system_error(errno,system_category(),String{"Can't open '",path.c_str(),"'"});
+			}
+
+			// The kernel expects the trailing nul; without CAP_SYS_RESOURCE the window
+			// must be a multiple of 2s.
+			if(::write(fd,spec,strlen(spec)+1) < 0) {
+				int err = errno;
+				::close(fd);
+				throw system_error(err,system_category(),String{"Can't register PSI trigger '",spec,"' on '",path.c_str(),"'"});
+			}
+
+			return fd;
+
+		}
+
+	protected:
+
+		void handle_event(const Event event) override {
+
+			if(event & (onerror|onhangup)) {
+				Logger::String{"Error on PSI trigger, disabling it"}.error(agent.name());
+				MainLoop::Handler::disable();
+				return;
+			}
+
+			fired = Root::now();
+
+			// Check again after the window, the state is released if the kernel is quiet.
+			Timer::set(window);
+			Timer::enable();
+
+			agent.triggered();
+
+		}
+
+		void on_timer() override {
+
+			if(!active()) {
+				Timer::disable();
+			}
+
+			agent.triggered();
+
+		}
+
+	public:
+
+		// The kernel reports PSI events as POLLPRI, not available in the Event enum.
+		Trigger(Pressure &a, const char *filename, const char *spec)
+			: MainLoop::Handler{-1,(MainLoop::Handler::Event) POLLPRI}, agent{a}, window{parse(spec)} {
+
+			MainLoop::Handler::set(open(filename,spec));
+			MainLoop::Handler::enable();
+
+		}
+
+		virtual ~Trigger() {
+			MainLoop::Handler::disable();
+			Timer::disable();
+			if(fd >= 0) {
+				::close(fd);
+				fd = -1;
+			}
+		}
+
+		/// @brief Check if the trigger has fired in the last window (with a margin for a late event).
+		inline bool active() const noexcept {
+			return fired && Root::now() < (fired + (window * 2));
+		}
+
+	};
+
+	class System::Pressure::State : public System::Pressure::BaseState {
+	private:
+
+		/// @brief Kernel trigger, null if the state is value based.
+		std::shared_ptr<Trigger> trigger;
+
+	public:
+		State(Pressure &agent, const XML::Node &node) : BaseState{node} {
+
+			String spec{node,"trigger",""};
+			if(spec.empty()) {
+				return;
+			}
+
+			try {
+				trigger = std::make_shared<Trigger>(agent,agent.filename.c_str(),spec.c_str());
+				Logger::String{"PSI trigger '",spec.c_str(),"' registered on ",agent.filename.c_str()}.trace(agent.name());
+			} catch(const std::exception &e) {
+				Logger::String{"Using value based state: ",e.what()}.warning(agent.name());
+			}
+
+		}
+
+		/// @brief Check if the state is active, from the kernel trigger or from the value.
+		bool active(float value) {
+			if(trigger) {
+				return trigger->active();
+			}
+			return compare(value);
+		}
+
+	};
+
+	std::shared_ptr<Abstract::Agent> System::Pressure::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<Pressure>(node,resource);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	System::Pressure::Pressure(const XML::Node &node, Resource r) : Agent<Percentage>{node}, resource{r}, history{node} {
+
+		static const struct {
+			const char *name;
+			const char *label;
+		} resources[] = {
+			{ "cpu",	N_( "CPU pressure" )		},
+			{ "memory",	N_( "Memory pressure" )		},
+			{ "io",		N_( "I/O pressure" )		},
+		};
+
+		// Optional file, cgroup or system wide.
+		{
+			String path{node,"pressure-file",""};
+			if(!path.empty()) {
+				filename = path.c_str();
+			} else {
+				std::string cgroup{CGroup::Controller::PathFactory(String{node,"cgroup",""}.c_str())};
+				if(cgroup.empty()) {
+					filename = string{"/proc/pressure/"} + resources[resource].name;
+				} else {
+					filename = string{"/sys/fs/cgroup/"} + cgroup + "/" + resources[resource].name + ".pressure";
+				}
+			}
+		}
+
+		{
+			String name{node,"line","some"};
+			if(!strcasecmp(name.c_str(),"some")) {
+				line = 0;
+			} else if(!strcasecmp(name.c_str(),"full")) {
+				line = 1;
+			} else {
+				throw system_error(EINVAL,system_category(),String{"Invalid PSI line '",name.c_str(),"'"});
+			}
+		}
+
+		{
+			String name{node,"average","avg10"};
+			if(!strcasecmp(name.c_str(),"avg10") || !strcmp(name.c_str(),"10")) {
+				field = 0;
+			} else if(!strcasecmp(name.c_str(),"avg60") || !strcmp(name.c_str(),"60")) {
+				field = 1;
+			} else if(!strcasecmp(name.c_str(),"avg300") || !strcmp(name.c_str(),"300")) {
+				field = 2;
+			} else {
+				throw system_error(EINVAL,system_category(),String{"Invalid PSI average '",name.c_str(),"'"});
+			}
+		}
+
+		source = std::make_shared<Source>(filename.c_str(),256);
+
+		Object::properties.icon = "utilities-system-monitor";
+
+		if(is_empty(Object::properties.label)) {
+#ifdef GETTEXT_PACKAGE
+			Object::properties.label = dgettext(GETTEXT_PACKAGE,resources[resource].label);
+#else
+			Object::properties.label = resources[resource].label;
+#endif // GETTEXT_PACKAGE
+		}
+
+	}
+
+	System::Pressure::~Pressure() {
+		watches.clear();
+	}
+
+	/// @brief Check for 'key' at the current position, skip it.
+	static inline bool expect(const char * &ptr, const char *key, size_t length) noexcept {
+		ptr = Scanner::blanks(ptr);
+		if(strncmp(ptr,key,length)) {
+			return false;
+		}
+		ptr += length;
+		return true;
+	}
+
+	bool System::Pressure::refresh() {
+
+		unsigned long long now = Root::now();
+
+		for(const char *ptr = source->read(); *ptr; ptr = Scanner::eol(ptr)) {
+
+			size_t ix;
+			if(expect(ptr,"some",4)) {
+				ix = 0;
+			} else if(expect(ptr,"full",4)) {
+				ix = 1;
+			} else {
+				continue;
+			}
+
+			double avg[3];
+			unsigned long long total;
+
+			if(!(expect(ptr,"avg10=",6) && Scanner::decimal(ptr,avg[0])
+					&& expect(ptr,"avg60=",6) && Scanner::decimal(ptr,avg[1])
+					&& expect(ptr,"avg300=",7) && Scanner::decimal(ptr,avg[2])
+					&& expect(ptr,"total=",6) && Scanner::number(ptr,total))) {
+				throw system_error(EINVAL,system_category(),String{"Unexpected format in '",filename.c_str(),"'"});
+			}
+
+			auto &values = lines[ix];
+
+			// The kernel averages are percentages.
+			for(size_t avgix = 0; avgix < 3; avgix++) {
+				values.avg[avgix] = (float) (avg[avgix] / 100.0);
+			}
+
+			if(timestamp && now > timestamp && total >= values.total) {
+				values.rate = ((float) (total - values.total)) / (((float) (now - timestamp)) * 1000.0);
+				if(values.rate > 1) {
+					values.rate = 1;
+				}
+			} else {
+				values.rate = 0;
+			}
+
+			values.total = total;
+
+		}
+
+		timestamp = now;
+
+		float value = lines[line].avg[field];
+		history.push_back(value);
+
+		return set(value);
+
+	}
+
+	void System::Pressure::triggered() noexcept {
+
+		try {
+
+			// Trigger states don't depend on the value, evaluate them even if it's the same.
+			if(!refresh()) {
+				updated(true);
+			}
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error updating pressure: ",e.what()}.error(name());
+
+		}
+
+	}
+
+	Udjat::Value & System::Pressure::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		value["file"] = filename.c_str();
+
+		static const char *names[] = { "some", "full" };
+
+		for(size_t ix = 0; ix < 2; ix++) {
+			auto &item = value[names[ix]];
+			item["avg10"].setFraction(lines[ix].avg[0]);
+			item["avg60"].setFraction(lines[ix].avg[1]);
+			item["avg300"].setFraction(lines[ix].avg[2]);
+			item["total"] = lines[ix].total;
+			item["rate"].setFraction(lines[ix].rate);
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> System::Pressure::StateFactory(const XML::Node &node) {
+		auto state = std::make_shared<State>(*this,node);
+		watches.push_back(state);
+		return state;
+	}
+
+	std::shared_ptr<Abstract::State> System::Pressure::computeState() {
+
+		float current = (float) this->get();
+
+		for(auto state : watches) {
+			if(state->active(current)) {
+				return state;
+			}
+		}
+
+		static const struct {
+			float value;			///< @brief State max value.
+			const char * name;		///< @brief State name.
+			Udjat::Level level;		///< @brief State level.
+			const char * summary;	///< @brief State summary.
+			const char * body;		///< @brief State description
+		} default_states[] = {
+			{
+				0.1,
+				"low",
+				Udjat::ready,
+				N_( "Stalled for ${value} of the time" ),
+				""
+			},
+			{
+				0.4,
+				"medium",
+				Udjat::warning,
+				N_( "Stalled for ${value} of the time" ),
+				""
+			},
+			{
+				1.01,
+				"high",
+				Udjat::error,
+				N_( "Stalled for ${value} of the time" ),
+				""
+			}
+		};
+
+		for(const auto &state : default_states) {
+			if(current < state.value) {
+
+				return Abstract::Agent::StateFactory(
+					state.name,
+					state.level,
+#ifdef GETTEXT_PACKAGE
+							dgettext(GETTEXT_PACKAGE,state.summary),
+							dgettext(GETTEXT_PACKAGE,state.body)
+#else
+							state.summary,
+							state.body
+#endif // GETTEXT_PACKAGE
+				);
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }
@@ -0,0 +1,504 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @page procpidstat /proc/[pid]/stat fields used
+  *
+  * Field | Name        | Description
+  * ------|-------------|---------------------------------------------------------
+  * 1     | pid         | The process ID.
+  * 2     | comm        | The filename of the executable, in parentheses.
+  * 10    | minflt      | Minor faults.
+  * 12    | majflt      | Major faults.
+  * 14    | utime       | Time scheduled in user mode, in clock ticks.
+  * 15    | stime       | Time scheduled in kernel mode, in clock ticks.
+  * 20    | num_threads | Number of threads.
+  * 22    | starttime   | Time the process started after system boot, in clock ticks.
+  * 24    | rss         | Resident set size, in pages (same value of /proc/[pid]/statm).
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/root.h>
+ #include <private/processtable.h>
+ #include <private/scanner.h>
+ #include <system_error>
+ #include <algorithm>
+ #include <cstring>
+ #include <cstdio>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/syscall.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "processes"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Directory entry from getdents64().
+	struct linux_dirent64 {
+		ino64_t d_ino;
+		off64_t d_off;
+		unsigned short d_reclen;
+		unsigned char d_type;
+		char d_name[];
+	};
+
+	/// @brief Minimum number of processes for the worker pool, smaller tables are loaded on the caller thread.
+	static const size_t parallel_threshold = 1024;
+
+	/// @brief Worker thread, loads a slice of the pid list.
+	class System::ProcessTable::Worker {
+	private:
+
+		std::mutex guard;
+		std::condition_variable condition;
+
+		bool running = true;
+		bool pending = false;
+
+		const ProcessTable *table = nullptr;
+		size_t from = 0;
+		size_t to = 0;
+		double seconds = 0;
+
+		std::thread thread;
+
+		void run() {
+
+			std::unique_lock<std::mutex> lock(guard);
+
+			while(true) {
+
+				condition.wait(lock,[this]{ return pending || !running; });
+
+				if(!running) {
+					break;
+				}
+
+				lock.unlock();
+				table->load(from,to,seconds,result);
+				lock.lock();
+
+				pending = false;
+				condition.notify_all();
+
+			}
+
+		}
+
+	public:
+
+		/// @brief The loaded processes.
+		std::vector<Process> result;
+
+		Worker() : thread{[this]{ run(); }} {
+		}
+
+		~Worker() {
+			{
+				std::lock_guard<std::mutex> lock(guard);
+				running = false;
+			}
+			condition.notify_all();
+			thread.join();
+		}
+
+		void start(const ProcessTable &t, size_t f, size_t l, double s) {
+			{
+				std::lock_guard<std::mutex> lock(guard);
+				table = &t;
+				from = f;
+				to = l;
+				seconds = s;
+				pending = true;
+			}
+			condition.notify_all();
+		}
+
+		void wait() {
+			std::unique_lock<std::mutex> lock(guard);
+			condition.wait(lock,[this]{ return !pending; });
+		}
+
+	};
+
+	System::ProcessTable & System::ProcessTable::getInstance() {
+		static ProcessTable instance;
+		return instance;
+	}
+
+	System::ProcessTable::Key System::ProcessTable::KeyFactory(const char *name) {
+
+		static const char *names[] = { "cpu", "rss", "faults", "threads" };
+
+		if(!(name && *name)) {
+			return CPU;
+		}
+
+		for(size_t ix = 0; ix < (sizeof(names)/sizeof(names[0])); ix++) {
+			if(!strcasecmp(name,names[ix])) {
+				return (Key) ix;
+			}
+		}
+
+		if(!strcasecmp(name,"memory")) {
+			return RSS;
+		}
+
+		throw system_error(EINVAL,system_category(),String{"Invalid process sort key '",name,"'"});
+
+	}
+
+	System::ProcessTable::ProcessTable() {
+
+		dents.resize(32768);
+
+		// The caller thread loads one slice, a small pool is enough; the load is syscall bound.
+		unsigned int cpus = std::thread::hardware_concurrency();
+		size_t count = (cpus > 1 ? std::min(cpus - 1, 3U) : 0);
+
+		for(size_t ix = 0; ix < count; ix++) {
+			workers.emplace_back(new Worker());
+		}
+
+	}
+
+	System::ProcessTable::~ProcessTable() {
+		workers.clear();
+		if(procfd >= 0) {
+			::close(procfd);
+		}
+	}
+
+	int System::ProcessTable::descriptor() {
+
+		unsigned int current = Root::generation();
+
+		if(procfd >= 0) {
+			if(generation == current) {
+				return procfd;
+			}
+			::close(procfd);
+			procfd = -1;
+		}
+
+		std::string path = Root::path("/proc");
+
+		procfd = ::open(path.c_str(),O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+		if(procfd < 0) {
+			throw system_error(errno,system_category(),String{"Can't open '",path.c_str(),"'"});
+		}
+
+		generation = current;
+		return procfd;
+
+	}
+
+	void System::ProcessTable::list() {
+
+		int fd = descriptor();
+
+		if(lseek(fd,0,SEEK_SET) < 0) {
+			throw system_error(errno,system_category(),"Can't rewind /proc");
+		}
+
+		pids.clear();
+
+		while(true) {
+
+			long bytes = syscall(SYS_getdents64,fd,dents.data(),dents.size());
+
+			if(bytes < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				throw system_error(errno,system_category(),"Can't read /proc");
+			}
+
+			if(bytes == 0) {
+				break;
+			}
+
+			for(long offset = 0; offset < bytes;) {
+
+				const struct linux_dirent64 *entry = (const struct linux_dirent64 *) (dents.data() + offset);
+				offset += entry->d_reclen;
+
+				const char *ptr = entry->d_name;
+				if(*ptr < '1' || *ptr > '9') {
+					continue;
+				}
+
+				pid_t pid = 0;
+				while(*ptr >= '0' && *ptr <= '9') {
+					pid = (pid * 10) + (*ptr - '0');
+					ptr++;
+				}
+
+				if(!*ptr) {
+					pids.push_back(pid);
+				}
+
+			}
+
+		}
+
+	}
+
+	static inline uint32_t hash(pid_t pid) noexcept {
+		return ((uint32_t) pid) * 2654435761U;
+	}
+
+	void System::ProcessTable::reindex() {
+
+		size_t size = 64;
+		while(size < (processes.size() * 2)) {
+			size <<= 1;
+		}
+
+		table.assign(size,Slot{});
+
+		uint32_t mask = (uint32_t) (size - 1);
+		for(size_t ix = 0; ix < processes.size(); ix++) {
+			uint32_t slot = hash(processes[ix].pid) & mask;
+			while(table[slot].pid) {
+				slot = (slot + 1) & mask;
+			}
+			table[slot].pid = processes[ix].pid;
+			table[slot].index = (uint32_t) ix;
+		}
+
+	}
+
+	const System::ProcessTable::Process * System::ProcessTable::find(pid_t pid) const noexcept {
+
+		if(table.empty()) {
+			return nullptr;
+		}
+
+		uint32_t mask = (uint32_t) (table.size() - 1);
+		for(uint32_t slot = hash(pid) & mask; table[slot].pid; slot = (slot + 1) & mask) {
+			if(table[slot].pid == pid) {
+				return &processes[table[slot].index];
+			}
+		}
+
+		return nullptr;
+
+	}
+
+	/// @brief Parse a signed number (negative values are stored as zero), advancing the pointer.
+	static inline bool field(const char * &ptr, unsigned long long &value) noexcept {
+
+		ptr = Scanner::blanks(ptr);
+
+		bool negative = (*ptr == '-');
+		if(negative) {
+			ptr++;
+		}
+
+		if(!Scanner::number(ptr,value)) {
+			return false;
+		}
+
+		if(negative) {
+			value = 0;
+		}
+
+		return true;
+	}
+
+	void System::ProcessTable::load(size_t from, size_t to, double seconds, std::vector<Process> &result) const noexcept {
+
+		static const double ticks_per_second = (double) sysconf(_SC_CLK_TCK);
+		static const unsigned long long page_size = (unsigned long long) sysconf(_SC_PAGESIZE);
+
+		result.clear();
+
+		for(size_t ix = from; ix < to; ix++) {
+
+			char path[32];
+			snprintf(path,sizeof(path),"%d/stat",(int) pids[ix]);
+
+			int fd = openat(procfd,path,O_RDONLY|O_CLOEXEC);
+			if(fd < 0) {
+				// The process has exited.
+				continue;
+			}
+
+			char buffer[1024];
+			ssize_t bytes = ::read(fd,buffer,sizeof(buffer)-1);
+			::close(fd);
+
+			if(bytes <= 0) {
+				continue;
+			}
+			buffer[bytes] = 0;
+
+			// The command name could have spaces and parenthesis, search for the last one.
+			const char *begin = strchr(buffer,'(');
+			const char *end = strrchr(buffer,')');
+			if(!(begin && end && end > begin)) {
+				continue;
+			}
+
+			result.emplace_back();
+			Process &process = result.back();
+
+			process.pid = pids[ix];
+
+			size_t length = std::min((size_t) (end - begin - 1),sizeof(process.name) - 1);
+			memcpy(process.name,begin+1,length);
+			process.name[length] = 0;
+
+			// Skip state, get fields 4 to 24.
+			const char *ptr = Scanner::blanks(end+1);
+			if(*ptr) {
+				ptr++;
+			}
+
+			unsigned long long fields[21];
+			size_t count = 0;
+			while(count < 21 && field(ptr,fields[count])) {
+				count++;
+			}
+
+			if(count < 21) {
+				result.pop_back();
+				continue;
+			}
+
+			process.minflt = fields[10-4];
+			process.majflts = fields[12-4];
+			process.ticks = fields[14-4] + fields[15-4];
+			process.threads = (unsigned int) fields[20-4];
+			process.start = fields[22-4];
+			process.rss = fields[24-4] * page_size;
+
+			const Process *previous = (seconds > 0 ? find(process.pid) : nullptr);
+			if(previous && previous->start == process.start) {
+
+				if(process.ticks >= previous->ticks) {
+					process.cpu = ((double) (process.ticks - previous->ticks)) / (seconds * ticks_per_second);
+				}
+
+				unsigned long long faults = process.minflt + process.majflts;
+				unsigned long long last = previous->minflt + previous->majflts;
+				if(faults >= last) {
+					process.faults = ((double) (faults - last)) / seconds;
+				}
+
+				if(process.majflts >= previous->majflts) {
+					process.majflt = ((double) (process.majflts - previous->majflts)) / seconds;
+				}
+
+			}
+
+		}
+
+	}
+
+	void System::ProcessTable::refresh(unsigned long max_age) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		unsigned long long now = Root::now();
+		if(timestamp && generation == Root::generation() && (now - timestamp) <= max_age) {
+			return;
+		}
+
+		list();
+
+		double seconds = ((timestamp && now > timestamp) ? ((double) (now - timestamp)) / 1000.0 : 0);
+
+		// Split the pid list, the caller thread loads the first slice.
+		size_t slices = (pids.size() >= parallel_threshold ? workers.size() + 1 : 1);
+		size_t length = (pids.size() + slices - 1) / slices;
+
+		for(size_t ix = 1; ix < slices; ix++) {
+			size_t from = std::min(ix * length,pids.size());
+			workers[ix-1]->start(*this,from,std::min(from + length,pids.size()),seconds);
+		}
+
+		load(0,std::min(length,pids.size()),seconds,loaded);
+
+		for(size_t ix = 1; ix < slices; ix++) {
+			workers[ix-1]->wait();
+			loaded.insert(loaded.end(),workers[ix-1]->result.begin(),workers[ix-1]->result.end());
+		}
+
+		// The previous scan is no longer required, reuse its buffer on the next one.
+		processes.swap(loaded);
+		reindex();
+
+		timestamp = now;
+
+	}
+
+	size_t System::ProcessTable::size() const {
+		std::lock_guard<std::mutex> lock(guard);
+		return processes.size();
+	}
+
+	void System::ProcessTable::top(Key key, size_t count, std::vector<Process> &result) const {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		order.resize(processes.size());
+		for(size_t ix = 0; ix < order.size(); ix++) {
+			order[ix] = (uint32_t) ix;
+		}
+
+		count = std::min(count,order.size());
+
+		auto value = [this,key](uint32_t ix) -> double {
+			const Process &process = processes[ix];
+			switch(key) {
+			case CPU:
+				return process.cpu;
+			case RSS:
+				return (double) process.rss;
+			case Faults:
+				return process.faults;
+			case Threads:
+				return (double) process.threads;
+			}
+			return 0;
+		};
+
+		std::partial_sort(order.begin(),order.begin()+count,order.end(),[&value](uint32_t a, uint32_t b){
+			return value(a) > value(b);
+		});
+
+		result.clear();
+		for(size_t ix = 0; ix < count; ix++) {
+			result.push_back(processes[order[ix]]);
+		}
+
+	}
+
+ }
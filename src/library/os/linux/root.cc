@@ -0,0 +1,263 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/configuration.h>
+ #include <system_error>
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <mutex>
+ #include <vector>
+ #include <cstdlib>
+ #include <cstring>
+ #include <dirent.h>
+
+ #ifdef LOG_DOMAIN
+	#undef LOG_DOMAIN
+ #endif
+ #define LOG_DOMAIN "sysinfo"
+ #include <udjat/tools/logger.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	namespace {
+
+		struct Step {
+			unsigned long long timestamp;
+			std::string name;
+		};
+
+		/// @brief The root state.
+		struct State {
+
+			std::mutex guard;
+
+			/// @brief The root directory, without trailing '/'.
+			std::string root;
+
+			/// @brief The replay directory, without trailing '/'.
+			std::string replay;
+
+			/// @brief Recorded snapshots, sorted by timestamp.
+			std::vector<Step> steps;
+
+			/// @brief Current snapshot.
+			size_t current = 0;
+
+			/// @brief Injected clock.
+			System::Root::Clock clock;
+
+			std::atomic<unsigned int> generation{0};
+
+			static std::string normalize(const char *path) {
+				std::string rc{path ? path : ""};
+				while(!rc.empty() && rc.back() == '/') {
+					rc.pop_back();
+				}
+				return rc;
+			}
+
+			void set(const char *path) {
+				root = normalize(path);
+				if(!root.empty()) {
+					Logger::String{"Reading system information from '",root.c_str(),"'"}.trace();
+				}
+				generation++;
+			}
+
+			size_t load(const char *path) {
+
+				replay = normalize(path);
+				steps.clear();
+				current = 0;
+
+				DIR *dir = opendir(path);
+				if(!dir) {
+					throw system_error(errno,system_category(),string{"Can't open '"} + path + "'");
+				}
+
+				struct dirent *entry;
+				while((entry = readdir(dir)) != NULL) {
+
+					if(entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+						continue;
+					}
+
+					char *end = nullptr;
+					unsigned long long timestamp = strtoull(entry->d_name,&end,10);
+					if(end && *end) {
+						continue;
+					}
+
+					steps.push_back({timestamp,entry->d_name});
+
+				}
+
+				closedir(dir);
+
+				std::sort(steps.begin(),steps.end(),[](const Step &a, const Step &b){
+					return a.timestamp < b.timestamp;
+				});
+
+				if(steps.empty()) {
+					throw system_error(ENOENT,system_category(),string{"No recorded snapshots in '"} + path + "'");
+				}
+
+				Logger::String{"Replaying ",steps.size()," snapshots from '",replay.c_str(),"'"}.trace();
+
+				generation++;
+				return steps.size();
+
+			}
+
+		};
+
+		State & state() {
+			static State instance;
+			return instance;
+		}
+
+	}
+
+	void System::Root::set(const char *path) {
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+		st.set(path);
+	}
+
+	void System::Root::set(const XML::Node &node) {
+
+		auto attribute = node.attribute("system-root");
+		if(attribute) {
+			set(attribute.as_string());
+		}
+
+		attribute = node.attribute("system-replay");
+		if(attribute) {
+			replay(attribute.as_string());
+		}
+
+	}
+
+	void System::Root::setup() {
+
+		// The environment overrides the configuration file.
+		const char *env = getenv("UDJAT_SYSTEM_ROOT");
+		if(env && *env) {
+			set(env);
+		} else {
+			Config::Value<std::string> root{"sysinfo","system-root",""};
+			if(!root.empty()) {
+				set(root.c_str());
+			}
+		}
+
+		env = getenv("UDJAT_SYSTEM_REPLAY");
+		if(env && *env) {
+			replay(env);
+		} else {
+			Config::Value<std::string> path{"sysinfo","system-replay",""};
+			if(!path.empty()) {
+				replay(path.c_str());
+			}
+		}
+
+	}
+
+	std::string System::Root::path(const char *path) {
+
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+
+		if(!st.steps.empty()) {
+			return st.replay + "/" + st.steps[st.current].name + path;
+		}
+
+		return st.root + path;
+
+	}
+
+	unsigned int System::Root::generation() noexcept {
+		return state().generation.load(std::memory_order_acquire);
+	}
+
+	size_t System::Root::replay(const char *path) {
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+		return st.load(path);
+	}
+
+	bool System::Root::replaying() noexcept {
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+		return !st.steps.empty();
+	}
+
+	bool System::Root::next() {
+
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+
+		if(st.current + 1 >= st.steps.size()) {
+			return false;
+		}
+
+		st.current++;
+		st.generation++;
+		return true;
+
+	}
+
+	unsigned long long System::Root::now() {
+
+		auto &st = state();
+		Clock clock;
+
+		{
+			std::lock_guard<std::mutex> lock(st.guard);
+
+			if(!st.steps.empty()) {
+				return st.steps[st.current].timestamp;
+			}
+
+			clock = st.clock;
+		}
+
+		if(clock) {
+			return clock();
+		}
+
+		return (unsigned long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count();
+
+	}
+
+	void System::Root::clock(const Clock &clock) {
+		auto &st = state();
+		std::lock_guard<std::mutex> lock(st.guard);
+		st.clock = clock;
+	}
+
+ }
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <private/source.h>
+ #include <private/keyedparser.h>
+ #include <private/scanner.h>
+ #include <udjat/tools/system/root.h>
+ #include <system_error>
+ #include <cstdlib>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	System::Sampler & System::Sampler::getInstance() {
+		static Sampler instance;
+		return instance;
+	}
+
+	System::Sampler::Sampler() {
+	}
+
+	void System::Sampler::collect(Snapshot &snapshot) {
+
+		snapshot.timestamp = Root::now();
+		snapshot.time = ::time(0);
+
+		// Read from procfs, the same counters used by sysinfo() and getloadavg(), to
+		// follow System::Root.
+
+		// /proc/uptime
+		{
+			static System::Source uptime{"/proc/uptime",128};
+
+			char buffer[128];
+			const char *ptr = buffer;
+			unsigned long long value;
+
+			uptime.read(buffer,sizeof(buffer));
+			if(!Scanner::number(ptr,value)) {
+				throw system_error(EINVAL,system_category(),"Unexpected format in /proc/uptime");
+			}
+
+			snapshot.uptime = (long) value;
+		}
+
+		// /proc/loadavg: 1, 5 and 15 minute averages, running/total entities.
+		{
+			static System::Source loadavg{"/proc/loadavg",128};
+
+			char buffer[128];
+			const char *ptr = buffer;
+			unsigned long long running, total;
+
+			loadavg.read(buffer,sizeof(buffer));
+			if(!(Scanner::decimal(ptr,snapshot.loadavg[0])
+					&& Scanner::decimal(ptr,snapshot.loadavg[1])
+					&& Scanner::decimal(ptr,snapshot.loadavg[2])
+					&& Scanner::number(ptr,running)
+					&& *ptr++ == '/'
+					&& Scanner::number(ptr,total))) {
+				throw system_error(EINVAL,system_category(),"Unexpected format in /proc/loadavg");
+			}
+
+			snapshot.procs = (unsigned short) total;
+		}
+
+		// /proc/meminfo, only the required fields.
+		{
+			static System::Source meminfo{"/proc/meminfo"};
+			static const KeyedParser parser{"MemTotal","MemAvailable","SwapTotal","SwapFree"};
+
+			unsigned long long values[4];
+			parser.parse(meminfo.read(),values);
+
+			snapshot.memtotal = values[0];
+			snapshot.memavailable = values[1];
+			snapshot.totalswap = values[2];
+			snapshot.freeswap = values[3];
+		}
+
+	}
+
+	System::Snapshot System::Sampler::get(unsigned long max_age) {
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		// Collect again if the snapshot is too old or if the root has changed.
+		unsigned int current = Root::generation();
+		if(!last.timestamp || generation != current || (Root::now() - last.timestamp) > max_age) {
+			collect(last);
+			generation = current;
+		}
+
+		return last;
+
+	}
+
+ }
@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/source.h>
+ #include <udjat/tools/system/root.h>
+ #include <system_error>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <errno.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	System::Source::Source(const char *p, size_t size) : path{p} {
+		buffer.resize(size < 64 ? 64 : size);
+	}
+
+	System::Source::~Source() {
+		close();
+	}
+
+	void System::Source::open() {
+
+		unsigned int current = Root::generation();
+
+		if(fd >= 0) {
+			if(generation == current) {
+				return;
+			}
+			// The root has changed, reopen.
+			close();
+		}
+
+		string filename = Root::path(path.c_str());
+
+		fd = ::open(filename.c_str(),O_RDONLY|O_CLOEXEC);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),string{"Can't open '"} + filename + "'");
+		}
+
+		generation = current;
+
+	}
+
+	void System::Source::close() noexcept {
+		if(fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+	}
+
+	int System::Source::descriptor() {
+		open();
+		return fd;
+	}
+
+	size_t System::Source::read(char *buf, size_t len) {
+
+		bool reopened = false;
+
+		open();
+
+		while(true) {
+
+			ssize_t bytes = pread(fd,buf,len-1,0);
+
+			if(bytes >= 0) {
+				buf[bytes] = 0;
+				return (size_t) bytes;
+			}
+
+			int err = errno;
+
+			if(err == EINTR) {
+				continue;
+			}
+
+			if((err == ENODEV || err == ESTALE) && !reopened) {
+				close();
+				open();
+				reopened = true;
+				continue;
+			}
+
+			close();
+			throw system_error(err,system_category(),string{"Can't read '"} + path + "'");
+
+		}
+
+	}
+
+	const char * System::Source::read() {
+
+		bool reopened = false;
+
+		open();
+
+		while(true) {
+
+			size_t space = buffer.size()-1;
+			ssize_t bytes = pread(fd,buffer.data(),space,0);
+
+			if(bytes < 0) {
+
+				int err = errno;
+
+				if(err == EINTR) {
+					continue;
+				}
+
+				if((err == ENODEV || err == ESTALE) && !reopened) {
+					// The descriptor is no longer valid, reopen and try again.
+					close();
+					open();
+					reopened = true;
+					continue;
+				}
+
+				close();
+				throw system_error(err,system_category(),string{"Can't read '"} + path + "'");
+
+			}
+
+			if(((size_t) bytes) < space) {
+				// Short read, the whole file is on the buffer.
+				length = (size_t) bytes;
+				break;
+			}
+
+			// Buffer is full, the file is larger than expected; grow and read it again
+			// from the start, the proc files are generated on every read.
+			buffer.resize(buffer.size() * 2);
+
+		}
+
+		buffer[length] = 0;
+		return buffer.data();
+
+	}
+
+ }
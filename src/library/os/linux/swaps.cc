@@ -0,0 +1,220 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/swaps.h>
+ #include <udjat/tools/system/vmstat.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/string.h>
+ #include <private/source.h>
+ #include <private/keyedparser.h>
+ #include <private/scanner.h>
+ #include <unistd.h>
+ #include <mutex>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Read a small sysfs file, false if it's not available.
+	static bool read(const char *path, char *buffer, size_t length) noexcept {
+
+		*buffer = 0;
+
+		if(access(System::Root::path(path).c_str(),R_OK)) {
+			return false;
+		}
+
+		try {
+
+			System::Source source{path,length};
+			source.read(buffer,length);
+
+		} catch(const std::exception &) {
+
+			*buffer = 0;
+			return false;
+
+		}
+
+		// Remove line break.
+		char *eol = strchr(buffer,'\n');
+		if(eol) {
+			*eol = 0;
+		}
+
+		return true;
+
+	}
+
+	/// @brief Get a /proc/swaps name, the kernel escapes blanks and backslashes as octal.
+	static const char * name(const char *ptr, std::string &str) {
+
+		str.clear();
+
+		ptr = Scanner::blanks(ptr);
+		while(*ptr && *ptr != ' ' && *ptr != '\t' && *ptr != '\n') {
+
+			if(*ptr == '\\' && ptr[1] >= '0' && ptr[1] <= '7' && ptr[2] >= '0' && ptr[2] <= '7' && ptr[3] >= '0' && ptr[3] <= '7') {
+				str += (char) (((ptr[1] - '0') << 6) | ((ptr[2] - '0') << 3) | (ptr[3] - '0'));
+				ptr += 4;
+				continue;
+			}
+
+			str += *ptr++;
+		}
+
+		return ptr;
+
+	}
+
+	/// @brief Get zram statistics from /sys/block/zram?/mm_stat.
+	static void zram(System::Swaps::Device &device) {
+
+		// https://www.kernel.org/doc/Documentation/admin-guide/blockdev/zram.rst
+		// mm_stat: orig_data_size compr_data_size mem_used_total mem_limit mem_used_max ...
+		if(strncmp(device.name.c_str(),"/dev/zram",9)) {
+			return;
+		}
+
+		char buffer[256];
+		if(!read(String{"/sys/block/",device.name.c_str()+5,"/mm_stat"}.c_str(),buffer,sizeof(buffer))) {
+			return;
+		}
+
+		const char *ptr = buffer;
+		if(!(Scanner::number(ptr,device.zram.original)
+				&& Scanner::number(ptr,device.zram.compressed)
+				&& Scanner::number(ptr,device.zram.memory))) {
+			return;
+		}
+
+		device.zram.valid = true;
+		device.zram.ratio = (device.zram.memory ? ((float) device.zram.original) / ((float) device.zram.memory) : 0);
+
+	}
+
+	void System::Swaps::refresh() {
+
+		// The sources are shared by every instance.
+		static std::mutex guard;
+
+		// /proc/swaps, sizes in kB.
+		// Filename		Type		Size		Used		Priority
+		// /dev/zram0	partition	8388604		0			100
+		{
+			static System::Source swaps{"/proc/swaps"};
+			std::lock_guard<std::mutex> lock(guard);
+
+			devices.clear();
+			size = used = 0;
+
+			// Skip header.
+			const char *ptr = Scanner::eol(swaps.read());
+
+			while(*ptr) {
+
+				Device device;
+
+				ptr = name(ptr,device.name);
+
+				const char *type = Scanner::blanks(ptr);
+				ptr = Scanner::word(type);
+				device.type.assign(type,ptr-type);
+
+				bool valid = (!device.name.empty()
+						&& Scanner::number(ptr,device.size)
+						&& Scanner::number(ptr,device.used));
+
+				// The priority is negative for swaps activated without one.
+				long long priority = 0;
+				ptr = Scanner::blanks(ptr);
+				bool negative = (*ptr == '-');
+				if(negative) {
+					ptr++;
+				}
+
+				if(valid && Scanner::number(ptr,priority)) {
+
+					device.size *= 1024;
+					device.used *= 1024;
+					device.priority = (int) (negative ? -priority : priority);
+
+					size += device.size;
+					used += device.used;
+
+					zram(device);
+					devices.push_back(std::move(device));
+
+				}
+
+				ptr = Scanner::eol(ptr);
+
+			}
+		}
+
+		// zswap parameters, the module directory is not available if zswap is not built.
+		unsigned long long now = System::Root::now();
+		if(!reloaded || now >= (reloaded + 60000)) {
+
+			reloaded = now;
+
+			char buffer[64];
+
+			zswap.enabled = (read("/sys/module/zswap/parameters/enabled",buffer,sizeof(buffer)) && (*buffer == 'Y' || *buffer == 'y' || *buffer == '1'));
+
+			read("/sys/module/zswap/parameters/compressor",buffer,sizeof(buffer));
+			zswap.compressor = buffer;
+
+			zswap.max_pool_percent = 0;
+			if(read("/sys/module/zswap/parameters/max_pool_percent",buffer,sizeof(buffer))) {
+				const char *ptr = buffer;
+				Scanner::number(ptr,zswap.max_pool_percent);
+			}
+		}
+
+		// zswap pool usage without debugfs, meminfo rows are available since kernel 6.1.
+		{
+			static System::Source meminfo{"/proc/meminfo"};
+			static const KeyedParser parser{"Zswap","Zswapped"};
+
+			unsigned long long values[2];
+			{
+				std::lock_guard<std::mutex> lock(guard);
+				parser.parse(meminfo.read(),values);
+			}
+
+			zswap.pool = values[0];
+			zswap.stored = values[1];
+			zswap.ratio = (zswap.pool ? ((float) zswap.stored) / ((float) zswap.pool) : 0);
+		}
+
+		// zswap load/store counters.
+		{
+			auto &counters = VmCounters::getInstance();
+			counters.refresh(1000);
+			zswap.in = counters.total(VmCounters::ZswapIn);
+			zswap.out = counters.total(VmCounters::ZswapOut);
+		}
+
+	}
+
+ }
@@ -20,12 +20,14 @@
  // https://www.kernel.org/doc/html/latest/filesystems/proc.html#miscellaneous-kernel-statistics-in-proc-stat
 
  #include <iostream>
- #include <sstream>
- #include <fstream>
  #include <iomanip>
  #include <cstring>
  #include <udjat/tools/system/stat.h>
+ #include <private/scanner.h>
+ #include <private/source.h>
+ #include <mutex>
  #include <ostream>
+ #include <system_error>
 
  using namespace std;
 
@@ -98,21 +100,140 @@
 
  namespace Udjat {
 
+	/// @brief Parse the counters of a "cpu" row.
+	/// @param ptr Pointer to the first character after the row name.
+	static const char * parse(System::Stat &st, const char *ptr) noexcept {
+
+		// Older kernels don't have the last fields, they will be kept as zero.
+		unsigned long *fields[] = {
+			&st.user,
+			&st.nice,
+			&st.system,
+			&st.idle,
+			&st.iowait,
+			&st.irq,
+			&st.softirq,
+			&st.steal,
+			&st.guest,
+			&st.guest_nice
+		};
+
+		for(auto field : fields) {
+			if(!Scanner::number(ptr,*field)) {
+				*field = 0;
+			}
+		}
+
+		return Scanner::eol(ptr);
+
+	}
+
 	System::Stat::Stat() {
 
-		ifstream in("/proc/stat", ifstream::in);
-		in.ignore(3);
-
-		in	>> user
-			>> nice
-			>> system
-			>> idle
-			>> iowait
-			>> irq
-			>> softirq
-			>> steal
-			>> guest
-			>> guest_nice;
+		// The aggregate row is allways the first one, no need to read the whole file.
+		static std::mutex guard;
+		static Source source{"/proc/stat"};
+
+		char buffer[512];
+
+		{
+			std::lock_guard<std::mutex> lock(guard);
+			if(source.read(buffer,sizeof(buffer)) < 4) {
+				throw system_error(EINVAL,system_category(),"Can't read /proc/stat");
+			}
+		}
+
+		if(strncmp(buffer,"cpu ",4)) {
+			throw system_error(EINVAL,system_category(),"Unexpected format in /proc/stat");
+		}
+
+		parse(*this,buffer+3);
+
+	}
+
+	System::Stats::Stats() : source{std::make_shared<Source>("/proc/stat",16384)} {
+		refresh();
+	}
+
+	void System::Stats::refresh() {
+		set(source->read());
+	}
+
+	void System::Stats::set(const char *ptr) {
+
+		// https://www.kernel.org/doc/html/latest/filesystems/proc.html#miscellaneous-kernel-statistics-in-proc-stat
+
+		for(size_t ix = 0; ix < online.size(); ix++) {
+			online[ix] = false;
+		}
+
+		while(*ptr) {
+
+			switch(*ptr) {
+			case 'c':
+				if(!strncmp(ptr,"cpu",3)) {
+
+					ptr += 3;
+
+					if(*ptr == ' ') {
+						ptr = parse(cpu,ptr);
+						continue;
+					}
+
+					size_t id;
+					if(Scanner::number(ptr,id)) {
+
+						if(id >= cpus.size()) {
+							cpus.resize(id+1);
+							online.resize(id+1,false);
+						}
+
+						online[id] = true;
+						ptr = parse(cpus[id],ptr);
+						continue;
+					}
+
+				} else if(Scanner::is(ptr,"ctxt",4)) {
+
+					ptr += 4;
+					Scanner::number(ptr,ctxt);
+
+				}
+				break;
+
+			case 'i':
+				if(Scanner::is(ptr,"intr",4)) {
+					ptr += 4;
+					Scanner::number(ptr,intr);
+				}
+				break;
+
+			case 'b':
+				if(Scanner::is(ptr,"btime",5)) {
+					ptr += 5;
+					Scanner::number(ptr,btime);
+				}
+				break;
+
+			case 'p':
+				if(Scanner::is(ptr,"processes",9)) {
+					ptr += 9;
+					Scanner::number(ptr,processes);
+				} else if(Scanner::is(ptr,"procs_running",13)) {
+					ptr += 13;
+					Scanner::number(ptr,procs_running);
+				} else if(Scanner::is(ptr,"procs_blocked",13)) {
+					ptr += 13;
+					Scanner::number(ptr,procs_blocked);
+				}
+				break;
+
+			}
+
+			ptr = Scanner::eol(ptr);
+
+		}
+
 	}
 
 	UDJAT_API System::Stat::Type System::Stat::TypeFactory(const char *name) {
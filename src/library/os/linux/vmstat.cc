@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system/vmstat.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/string.h>
+ #include <private/source.h>
+ #include <private/keyedparser.h>
+ #include <system_error>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static const char * names[] = {
+		"pswpin",
+		"pswpout",
+		"pgfault",
+		"pgmajfault",
+		"pgscan_kswapd",
+		"pgscan_direct",
+		"pgsteal_kswapd",
+		"pgsteal_direct",
+		"allocstall",
+		"compact_stall",
+		"oom_kill",
+		"zswpin",
+		"zswpout",
+	};
+
+	System::VmCounters::Counter System::VmCounters::CounterFactory(const char *name) {
+
+		for(size_t ix = 0; ix < (sizeof(names)/sizeof(names[0])); ix++) {
+			if(!strcasecmp(name,names[ix])) {
+				return (Counter) ix;
+			}
+		}
+
+		throw system_error(EINVAL,system_category(),String{"Unexpected vmstat field '",name,"'"});
+
+	}
+
+	System::VmCounters::Counter System::VmCounters::CounterFactory(const XML::Node &node, const char *def) {
+		return CounterFactory(node.attribute("field-name").as_string(def));
+	}
+
+	const char * System::VmCounters::name(const Counter counter) noexcept {
+		if(counter < COUNT) {
+			return names[counter];
+		}
+		return "unknown";
+	}
+
+	System::VmCounters & System::VmCounters::getInstance() {
+		static VmCounters instance;
+		return instance;
+	}
+
+	System::VmCounters::VmCounters() {
+		for(size_t ix = 0; ix < COUNT; ix++) {
+			totals[ix] = 0;
+		}
+	}
+
+	void System::VmCounters::refresh(unsigned long max_age) {
+
+		// https://www.kernel.org/doc/Documentation/vm/
+
+		// Same order of the Counter enum; allocstall was split by zone on kernel 4.10,
+		// the zone counters are added to the first one.
+		static const KeyedParser parser{
+			"pswpin",
+			"pswpout",
+			"pgfault",
+			"pgmajfault",
+			"pgscan_kswapd",
+			"pgscan_direct",
+			"pgsteal_kswapd",
+			"pgsteal_direct",
+			"allocstall",
+			"compact_stall",
+			"oom_kill",
+			"zswpin",
+			"zswpout",
+			"allocstall_dma",
+			"allocstall_dma32",
+			"allocstall_normal",
+			"allocstall_movable",
+			"allocstall_device",
+		};
+
+		static System::Source vmstat{"/proc/vmstat",8192};
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		unsigned long long now = Root::now();
+		if(timestamp && (now - timestamp) <= max_age) {
+			return;
+		}
+
+		unsigned long long values[18];
+		parser.parse(vmstat.read(),values);
+
+		for(size_t ix = COUNT; ix < 18; ix++) {
+			values[AllocStall] += values[ix];
+		}
+
+		for(size_t ix = 0; ix < COUNT; ix++) {
+			totals[ix] = values[ix];
+		}
+
+		timestamp = now;
+
+	}
+
+	unsigned long long System::VmCounters::total(const Counter counter) const {
+		std::lock_guard<std::mutex> lock(guard);
+		return counter < COUNT ? totals[counter] : 0;
+	}
+
+	System::VmCounters::Rates::Rates() {
+		for(size_t ix = 0; ix < COUNT; ix++) {
+			totals[ix] = 0;
+			values[ix] = 0;
+		}
+	}
+
+	void System::VmCounters::Rates::update(const VmCounters &counters) {
+
+		unsigned long long now;
+		unsigned long long current[COUNT];
+
+		{
+			std::lock_guard<std::mutex> lock(counters.guard);
+			now = counters.timestamp;
+			for(size_t ix = 0; ix < COUNT; ix++) {
+				current[ix] = counters.totals[ix];
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(guard);
+
+		if(now == timestamp) {
+			// Same read, keep the last rates.
+			return;
+		}
+
+		if(timestamp && now > timestamp) {
+
+			float seconds = ((float) (now - timestamp)) / 1000.0;
+
+			for(size_t ix = 0; ix < COUNT; ix++) {
+				values[ix] = (current[ix] >= totals[ix] ? ((float) (current[ix] - totals[ix])) / seconds : 0);
+			}
+
+			float scanned = values[ScanKswapd] + values[ScanDirect];
+			reclaimed = (scanned > 0 ? (values[StealKswapd] + values[StealDirect]) / scanned : 1);
+
+		}
+
+		for(size_t ix = 0; ix < COUNT; ix++) {
+			totals[ix] = current[ix];
+		}
+
+		timestamp = now;
+
+	}
+
+	float System::VmCounters::Rates::operator[](const Counter counter) const {
+		std::lock_guard<std::mutex> lock(guard);
+		return counter < COUNT ? values[counter] : 0;
+	}
+
+	float System::VmCounters::Rates::efficiency() const {
+		std::lock_guard<std::mutex> lock(guard);
+		return reclaimed;
+	}
+
+ }
+
+ namespace std {
+
+	UDJAT_API const char * to_string(const Udjat::System::VmCounters::Counter counter) noexcept {
+		return Udjat::System::VmCounters::name(counter);
+	}
+
+ }
@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/action.h>
+ #include <udjat/tools/actions/processes.h>
+ #include <udjat/tools/response.h>
+ #include <udjat/tools/report.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/storage/unit.h>
+ #include <private/processtable.h>
+ #include <memory>
+ #include <vector>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Udjat::Action> Processes::Action::Factory::ActionFactory(const XML::Node &node) const {
+		return make_shared<Processes::Action>(node);
+	}
+
+	Processes::Action::Action(const XML::Node &node)
+		: Udjat::Action{node}, unit{Storage::UnitFactory(node)},
+			key{(unsigned char) System::ProcessTable::KeyFactory(node.attribute("sort-by").as_string("cpu"))},
+			count{node.attribute("count").as_uint(10)},
+			max_age{node.attribute("max-age").as_uint(1000)} {
+
+		// First scan, the rates are available on the next one.
+		System::ProcessTable::getInstance().refresh();
+
+	}
+
+	Processes::Action::~Action() {
+	}
+
+	/// @brief Fill report row.
+	static void row(const System::ProcessTable::Process &process, Udjat::Value &value, const Storage::Unit unit) {
+
+		value["pid"] = (int) process.pid;
+		value["name"] = process.name;
+		value["cpu"].setFraction(process.cpu);
+		value["rss"] = std::to_string((float) process.rss,unit);
+		value["faults/s"] = process.faults;
+		value["majflt/s"] = process.majflt;
+		value["threads"] = process.threads;
+
+	}
+
+	int Processes::Action::call(Udjat::Request &request, Udjat::Response &response, bool except) {
+
+		return exec(response,except,[&]() -> int {
+
+			auto &table = System::ProcessTable::getInstance();
+			table.refresh(max_age);
+
+			std::vector<System::ProcessTable::Process> processes;
+			table.top((System::ProcessTable::Key) key,count,processes);
+
+			if(processes.empty()) {
+				throw system_error(ENODATA,system_category());
+			}
+
+			auto it = processes.begin();
+
+			// Get first line.
+			Value value;
+			row(*it,value,this->unit);
+
+			auto &report = response.ReportFactory(value);
+
+			while(++it != processes.end()) {
+				value.clear();
+				row(*it,value,this->unit);
+				report << value;
+			}
+
+			return 0;
+
+		});
+
+	}
+
+ }
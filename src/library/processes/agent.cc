@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/processes.h>
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/sampler.h>
+ #include <private/processtable.h>
+ #include <system_error>
+ #include <memory>
+ #include <vector>
+ #include <unistd.h>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Abstract::Agent> Processes::Top::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<Top>(node);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	Processes::Top::Top(const XML::Node &node)
+		: Agent<Percentage>{node},
+			key{(unsigned char) System::ProcessTable::KeyFactory(node.attribute("sort-by").as_string("cpu"))},
+			count{node.attribute("count").as_uint(5)} {
+
+		if(key != System::ProcessTable::CPU && key != System::ProcessTable::RSS) {
+			throw system_error(EINVAL,system_category(),"The process agent is sorted by 'cpu' or 'rss', use the processes action for other keys");
+		}
+
+		Object::properties.icon = "utilities-system-monitor";
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = (key == System::ProcessTable::CPU ? _( "Top process by CPU" ) : _( "Top process by memory" ));
+		}
+
+	}
+
+	Processes::Top::~Top() {
+	}
+
+	bool Processes::Top::refresh() {
+
+		auto &table = System::ProcessTable::getInstance();
+		table.refresh(1000);
+
+		std::vector<System::ProcessTable::Process> processes;
+		table.top((System::ProcessTable::Key) key,1,processes);
+
+		if(processes.empty()) {
+			return set(0);
+		}
+
+		float value = 0;
+
+		if(key == System::ProcessTable::CPU) {
+
+			long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+			value = (cpus > 0 ? processes[0].cpu / ((float) cpus) : 0);
+
+		} else {
+
+			unsigned long long memtotal = System::Sampler::getInstance().get(60000).memtotal;
+			value = (memtotal ? ((float) processes[0].rss) / ((float) memtotal) : 0);
+
+		}
+
+		if(value > 1) {
+			value = 1;
+		}
+
+		return set(value);
+
+	}
+
+	Udjat::Value & Processes::Top::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		try {
+
+			std::vector<System::ProcessTable::Process> processes;
+			System::ProcessTable::getInstance().top((System::ProcessTable::Key) key,count,processes);
+
+			auto &list = value["processes"];
+			for(size_t ix = 0; ix < processes.size(); ix++) {
+				auto &row = list[std::to_string(ix).c_str()];
+				row["pid"] = (int) processes[ix].pid;
+				row["name"] = processes[ix].name;
+				row["cpu"].setFraction(processes[ix].cpu);
+				row["rss"] = processes[ix].rss;
+				row["faults"] = processes[ix].faults;
+				row["threads"] = processes[ix].threads;
+			}
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error getting processes: ",e.what()}.error(name());
+
+		}
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> Processes::Top::computeState() {
+
+		float current = (float) this->get();
+		for(auto state : states) {
+			if(state->compare(current))
+				return state;
+		}
+
+		static const struct {
+			float value;			///< @brief State max value.
+			const char * name;		///< @brief State name.
+			Udjat::Level level;		///< @brief State level.
+			const char * summary;	///< @brief State summary.
+			const char * body;		///< @brief State description
+		} default_states[] = {
+			{
+				0.5,
+				"low",
+				Udjat::ready,
+				N_( "${value} used by a single process" ),
+				""
+			},
+			{
+				0.8,
+				"medium",
+				Udjat::warning,
+				N_( "${value} used by a single process" ),
+				""
+			},
+			{
+				1.01,
+				"high",
+				Udjat::error,
+				N_( "${value} used by a single process" ),
+				""
+			}
+		};
+
+		for(const auto &state : default_states) {
+			if(current < state.value) {
+
+				return Abstract::Agent::StateFactory(
+					state.name,
+					state.level,
+#ifdef GETTEXT_PACKAGE
+							dgettext(GETTEXT_PACKAGE,state.summary),
+							dgettext(GETTEXT_PACKAGE,state.body)
+#else
+							state.summary,
+							state.body
+#endif // GETTEXT_PACKAGE
+				);
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }
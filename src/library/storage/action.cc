@@ -28,9 +28,13 @@
  #include <udjat/tools/string.h>
  #include <udjat/tools/intl.h>
  #include <udjat/tools/timer.h>
+ #include <udjat/tools/timestamp.h>
  #include <udjat/tools/value.h>
  #include <udjat/tools/storage/unit.h>
  #include <memory>
+ #include <vector>
+ #include <functional>
+ #include <cstring>
  
  using namespace std;
 
@@ -40,8 +44,23 @@
 		return make_shared<Storage::Action>(node);	
 	}
 
-	Storage::Action::Action(const XML::Node &node) : Udjat::Action{node}, unit{Storage::UnitFactory(node)} {
-		
+	static Storage::Action::Contents ContentsFactory(const XML::Node &node) {
+
+		static const char *names[] = { "stats", "history", "rollup" };
+
+		const char *name = node.attribute("report").as_string(names[0]);
+		for(size_t ix = 0; ix < (sizeof(names)/sizeof(names[0])); ix++) {
+			if(!strcasecmp(name,names[ix])) {
+				return (Storage::Action::Contents) ix;
+			}
+		}
+
+		throw system_error(EINVAL,system_category(),String{"Invalid storage report '",name,"'"});
+
+	}
+
+	Storage::Action::Action(const XML::Node &node) : Udjat::Action{node}, unit{Storage::UnitFactory(node)}, contents{ContentsFactory(node)} {
+
 		auto &controller = Storage::Controller::getInstance();
 		for(const auto &unit : Storage::Stat::get()) {
 			if(unit.physical()) {
@@ -60,30 +79,128 @@
 		// Do nothing, it's just a placeholder.
 	}
 
+	/// @brief Emit one row for every read/write sample, the rings share the timestamps.
+	static void history(const Storage::Data &data, const Storage::Unit unit, const std::function<void(Udjat::Value &value)> &emit) {
+
+		std::vector<std::pair<time_t,float>> reads;
+		reads.reserve(data.history.read->size());
+		data.history.read->for_each([&](time_t timestamp, float value){
+			reads.emplace_back(timestamp,value);
+		});
+
+		size_t ix = 0;
+		data.history.write->for_each([&](time_t timestamp, float value){
+
+			if(ix >= reads.size()) {
+				return;
+			}
+
+			Value row;
+			row["device"] = data.c_str();
+			row["time"] = TimeStamp{reads[ix].first};
+			row["read"] = std::to_string(reads[ix].second,unit);
+			row["write"] = std::to_string(value,unit);
+			ix++;
+
+			emit(row);
+
+		});
+
+	}
+
+	/// @brief Emit one row for every bucket of every rollup tier.
+	static void rollup(const Storage::Data &data, const Storage::Unit unit, const std::function<void(Udjat::Value &value)> &emit) {
+
+		struct Bucket {
+			time_t start;
+			float min, max, avg;
+		};
+
+		for(auto width : data.history.read->widths()) {
+
+			std::vector<Bucket> reads;
+			data.history.read->for_each(width,[&](time_t start, float min, float max, float avg, float, unsigned int){
+				reads.push_back(Bucket{start,min,max,avg});
+			});
+
+			size_t ix = 0;
+			data.history.write->for_each(width,[&](time_t start, float min, float max, float avg, float, unsigned int){
+
+				if(ix >= reads.size()) {
+					return;
+				}
+
+				const Bucket &read = reads[ix++];
+
+				Value row;
+				row["device"] = data.c_str();
+				row["width"] = width;
+				row["time"] = TimeStamp{read.start};
+				row["read-min"] = std::to_string(read.min,unit);
+				row["read-max"] = std::to_string(read.max,unit);
+				row["read-avg"] = std::to_string(read.avg,unit);
+				row["write-min"] = std::to_string(min,unit);
+				row["write-max"] = std::to_string(max,unit);
+				row["write-avg"] = std::to_string(avg,unit);
+
+				emit(row);
+
+			});
+
+		}
+
+	}
+
 	int Storage::Action::call(Udjat::Request &request, Udjat::Response &response, bool except) {
 
 		return exec(response,except,[&]() -> int {
 
-			auto cntrl = Storage::Controller::getInstance();
-			auto it = cntrl.begin();
-			if(it == cntrl.end()) {
+			// Get the last published data, no copy, no lock.
+			auto snapshot = Storage::Controller::getInstance().snapshot();
+			if(!snapshot || snapshot->empty()) {
 				throw system_error(ENODATA,system_category());
 			}
 
+			if(contents != Statistics) {
+
+				// The first row builds the report.
+				Udjat::Report *report = nullptr;
+				auto emit = [&](Udjat::Value &row) {
+					if(report) {
+						*report << row;
+					} else {
+						report = &response.ReportFactory(row);
+					}
+				};
+
+				for(const auto &data : *snapshot) {
+					if(contents == History) {
+						history(data,this->unit,emit);
+					} else {
+						rollup(data,this->unit,emit);
+					}
+				}
+
+				if(!report) {
+					throw system_error(ENODATA,system_category(),_("No history on the storage devices"));
+				}
+
+				return 0;
+
+			}
+
+			auto it = snapshot->begin();
+
 			// Get first line.
 			Value value;
-			value["device"] = it->c_str();
-			value["read"] = std::to_string(it->read,this->unit);
-			value["write"] = std::to_string(it->write,this->unit);
+			it->row(value,this->unit);
 			getValues(*it,value);
 
 			auto &report = response.ReportFactory(value);
 
-			while(++it != cntrl.end()) {
+			while(++it != snapshot->end()) {
 				value.clear();
-				value["device"] = it->c_str();
-				value["read"] = std::to_string(it->read,this->unit);
-				value["write"] = std::to_string(it->write,this->unit);
+				it->row(value,this->unit);
 				getValues(*it,value);
 				report << value;
 			}
@@ -22,6 +22,8 @@
  #include <udjat/tools/xml.h>
  #include <udjat/tools/container.h>
  #include <udjat/tools/storage/stat.h>
+ #include <private/scanner.h>
+ #include <udjat/tools/system/root.h>
 
  #ifdef LOG_DOMAIN
 	#undef LOG_DOMAIN
@@ -30,6 +32,7 @@
  #include <udjat/tools/logger.h>
 
  #include <private/storagecontroller.h>
+ #include <private/historyfile.h>
  
  namespace Udjat {
 
@@ -47,71 +50,194 @@
 		}
 
 		Logger::String{"Watching ",stat.name()}.trace();
-		emplace_back(stat);
+		index[key(stat.major,stat.minor)] = size();
+		emplace_back(stat,depth);
+		found.push_back(false);
+
+		if(!rollup.empty()) {
+			back().history.read->rollup(rollup.c_str());
+			back().history.write->rollup(rollup.c_str());
+		}
+
+		if(depth && System::HistoryFile::getInstance().is_open()) {
+			back().persist();
+		}
+
+		publish();
+
+		return true;
+
+	}
+
+	void Storage::Controller::reindex() {
+
+		index.clear();
+		for(size_t ix = 0; ix < size(); ix++) {
+			index[key(at(ix).major,at(ix).minor)] = ix;
+		}
+
+		found.assign(size(),false);
+
+	}
+
+	bool Storage::Controller::remove(unsigned int major, unsigned int minor) {
+
+		auto entry = index.find(key(major,minor));
+		if(entry == index.end()) {
+			return false;
+		}
+
+		Logger::String{"Removing ",at(entry->second).name()}.trace();
+
+		Stat::forget(major,minor);
+		erase(std::vector<Data>::begin() + entry->second);
+		reindex();
+		publish();
 
 		return true;
 
 	}
 
+	void Storage::Controller::reconcile() {
+
+		reconciled = System::Root::now();
+
+		for(const auto &unit : Storage::Stat::get()) {
+			if(unit.physical()) {
+				push_back(unit);
+			}
+		}
+
+	}
+
 	void Storage::Controller::setup(const XML::Node &node) {
 		
 		debug("Setting up controller from <",node.name(),"> node (timer-interval=",node.attribute("timer-interval").as_uint(0),")");
 
 		const char *domain = node.attribute("name").as_string(LOG_DOMAIN);
 
-		auto saved_interval = interval();
-		if(!saved_interval) {
-			saved_interval = 60000L;
+		Updater::setup(node,domain,60000L);
+		Updater::autoupdate(domain);
+
+		reconcile_interval = ((unsigned long long) node.attribute("reconcile-interval").as_uint(reconcile_interval/1000)) * 1000;
+		if(!reconciled) {
+			reconciled = System::Root::now();
 		}
-		debug("---------------------> ",saved_interval);
 
-		Timer::set(node);
-		debug("Set to ",interval()," from xml");
+		if(!monitor && node.attribute("hotplug").as_bool(true)) {
+			try {
+				monitor = MonitorFactory();
+			} catch(const std::exception &e) {
+				Logger::String{"Block device hotplug is disabled: ",e.what()}.warning(domain);
+			}
+		}
 
-		if(saved_interval < interval() || interval() == 0) {
-			Timer::set(saved_interval);
-			Logger::String{"Keeping original timer of ",Timer::interval(),"ms"}.trace(domain);
-		} else {
-			Logger::String{"Update timer set to ",Timer::interval(),"ms"}.trace(domain);
+		// Optional read/write history, the deepest one requested.
+		size_t history = node.attribute("history").as_uint(0);
+		if(history > depth) {
+			depth = history;
+			Logger::String{"Keeping ",depth," samples of disk history"}.trace(domain);
+			for(auto &data : *this) {
+				data.history.read->resize(depth);
+				data.history.write->resize(depth);
+			}
 		}
 
-		if(Timer::enable()) {
-			Logger::String{"Auto update was enabled"}.trace(domain);
+		if(depth && System::HistoryFile::getInstance().open(node)) {
+			for(auto &data : *this) {
+				data.persist();
+			}
+		}
+
+		const char *tiers = node.attribute("rollup").as_string("");
+		if(*tiers) {
+			rollup = tiers;
+			Logger::String{"Disk history rollup set to '",tiers,"'"}.trace(domain);
+			for(auto &data : *this) {
+				data.history.read->rollup(tiers);
+				data.history.write->rollup(tiers);
+			}
 		}
 
 	}
 
-	void Storage::Controller::on_timer() {
+	void Storage::Controller::refresh() {
 
 		try {
 
-			for(Data &stat : (std::vector<Data>) *this) {
+			// https://www.kernel.org/doc/Documentation/iostats.txt
+
+			for(size_t ix = 0; ix < found.size(); ix++) {
+				found[ix] = false;
+			}
+
+			// Read /proc/diskstats once and dispatch rows by major:minor.
+			for(const char *ptr = diskstats.read(); *ptr; ptr = Scanner::eol(ptr)) {
+
+				unsigned int major, minor;
+				if(!(Scanner::number(ptr,major) && Scanner::number(ptr,minor))) {
+					continue;
+				}
+
+				auto entry = index.find(key(major,minor));
+				if(entry == index.end()) {
+					continue;
+				}
+
+				Data &data = at(entry->second);
+				found[entry->second] = true;
 
-				debug("Updating ",stat.name());
+				debug("Updating ",data.name());
 
 				try {
 
+					// Skip device name, get counters.
+					Storage::Stat stat;
+					stat.load(Scanner::word(Scanner::blanks(ptr)));
+
 					// Update disk speed.
-					stat.refresh();
+					data.update(stat);
 
 					// Complete, reset error.
-					stat.error.clear();
+					data.error.clear();
 
 				} catch(const std::exception &e) {
 
-					stat.error = e.what();
-					Logger::String{"Error updating disk status: ",e.what()}.error();
+					data.error = e.what();
+					Logger::String{"Error updating ",data.name()," status: ",e.what()}.error();
 
 				}
 
 			}
 
+			// Disks no longer in /proc/diskstats were removed (lost hotplug event).
+			bool removed = false;
+			for(size_t ix = found.size(); ix-- > 0;) {
+				if(!found[ix]) {
+					Logger::String{"Removing ",at(ix).name(),", not found in /proc/diskstats"}.trace();
+					Stat::forget(at(ix).major,at(ix).minor);
+					erase(std::vector<Data>::begin() + ix);
+					removed = true;
+				}
+			}
+
+			if(removed) {
+				reindex();
+			}
+
+			// Fallback rescan, new disks are usually added by the hotplug monitor.
+			if(reconcile_interval && System::Root::now() >= (reconciled + reconcile_interval)) {
+				reconcile();
+			}
+
 		} catch(const std::exception &e) {
 
 			Logger::String{"Error on disk controller: ",e.what()}.error();
 			
 		}
 
+		publish();
+
 	}
 
  }
@@ -22,6 +22,10 @@
  #include <udjat/tools/xml.h>
  #include <string>
  #include <udjat/tools/storage/stat.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/system/root.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/storage/unit.h>
 
  #include <private/storagecontroller.h>
 
@@ -29,13 +33,124 @@
 
  namespace Udjat {
 
+	void Storage::Data::row(Udjat::Value &value, const Storage::Unit unit) const {
+
+		value["device"] = c_str();
+		value["read"] = std::to_string(read,unit);
+		value["write"] = std::to_string(write,unit);
+
+		// Extended statistics, same as 'iostat -x'.
+		value["r/s"] = iostat.rps;
+		value["w/s"] = iostat.wps;
+		value["rareq-sz"] = std::to_string(iostat.rareq,unit);
+		value["wareq-sz"] = std::to_string(iostat.wareq,unit);
+		value["r_await"] = iostat.r_await;
+		value["w_await"] = iostat.w_await;
+		value["aqu-sz"] = iostat.aqu;
+		value["rrqm"].setFraction(iostat.rrqm);
+		value["wrqm"].setFraction(iostat.wrqm);
+		value["util"].setFraction(iostat.util);
+		value["discard"] = std::to_string(iostat.discard,unit);
+
+	}
+
 	void Storage::Data::refresh() {
+		Storage::Stat stat;
+		stat.load(source->read());
+		update(stat);
+	}
+
+	void Storage::Data::persist() {
+
+		if(!(history.read->persist(String{"disk.",name(),".read"}.c_str())
+				&& history.write->persist(String{"disk.",name(),".write"}.c_str()))) {
+			return;
+		}
+
+		// Counters from the previous run, invalid after a reboot.
+		double counters[4];
+		if(history.read->restore(counters,4)) {
+			saved.read.bytes = (float) counters[0];
+			saved.read.time = (unsigned int) counters[1];
+			saved.write.bytes = (float) counters[2];
+			saved.write.time = (unsigned int) counters[3];
+		}
+
+	}
+
+	/// @brief Get counter delta, zero if the counter was reset.
+	static inline double delta(unsigned long current, unsigned long previous) noexcept {
+		return current >= previous ? (double) (current - previous) : 0;
+	}
+
+	void Storage::Data::extend(const Storage::Stat &stat) {
+
+		// https://www.kernel.org/doc/Documentation/iostats.txt
+		// https://github.com/sysstat/sysstat/blob/master/rd_stats.c (compute_ext_disk_stats)
+
+		static const double sector_size = (double) Storage::Stat::sector_size;
+
+		unsigned long long now = System::Root::now();
 
-		Storage::Stat stat{name()};
+		const unsigned long count[3] = { stat.read.count, stat.write.count, stat.discards.count };
+		const unsigned long merged[3] = { stat.read.merged, stat.write.merged, stat.discards.merged };
+		const unsigned long sectors[3] = { stat.read.blocks, stat.write.blocks, stat.discards.blocks };
+		const unsigned long time[3] = { stat.read.time, stat.write.time, stat.discards.time };
+
+		if(last.timestamp && now > last.timestamp) {
+
+			double interval = ((double) (now - last.timestamp)) / 1000.0;
+
+			double ios[3], merges[3], bytes[3], ticks[3];
+			for(size_t ix = 0; ix < 3; ix++) {
+				ios[ix] = delta(count[ix],last.count[ix]);
+				merges[ix] = delta(merged[ix],last.merged[ix]);
+				bytes[ix] = delta(sectors[ix],last.sectors[ix]) * sector_size;
+				ticks[ix] = delta(time[ix],last.time[ix]);
+			}
+
+			// The 32 bit io counters wrap, unsigned arithmetic handles it.
+			double io = (double) ((unsigned int) (stat.io.time - last.io));
+			double weighted = (double) ((unsigned int) (stat.io.weighted - last.weighted));
+
+			iostat.rps = ios[0] / interval;
+			iostat.wps = ios[1] / interval;
+			iostat.rareq = ios[0] > 0 ? bytes[0] / ios[0] : 0;
+			iostat.wareq = ios[1] > 0 ? bytes[1] / ios[1] : 0;
+			iostat.r_await = ios[0] > 0 ? ticks[0] / ios[0] : 0;
+			iostat.w_await = ios[1] > 0 ? ticks[1] / ios[1] : 0;
+			iostat.aqu = weighted / (interval * 1000.0);
+			iostat.util = io / (interval * 1000.0);
+			iostat.rrqm = (ios[0] + merges[0]) > 0 ? merges[0] / (ios[0] + merges[0]) : 0;
+			iostat.wrqm = (ios[1] + merges[1]) > 0 ? merges[1] / (ios[1] + merges[1]) : 0;
+			iostat.discard = bytes[2] / interval;
+
+			if(iostat.util > 1) {
+				iostat.util = 1;
+			}
+
+		}
+
+		last.timestamp = now;
+		for(size_t ix = 0; ix < 3; ix++) {
+			last.count[ix] = count[ix];
+			last.merged[ix] = merged[ix];
+			last.sectors[ix] = sectors[ix];
+			last.time[ix] = time[ix];
+		}
+		last.io = stat.io.time;
+		last.weighted = stat.io.weighted;
+
+	}
+
+	void Storage::Data::update(const Storage::Stat &stat) {
+
+		// The kernel counters are allways in 512 bytes sectors.
+		static const float sector_size = (float) Storage::Stat::sector_size;
 
 		// Get this cicle values.
-		float bytes_read = (stat.read.blocks * blocksize) - saved.read.bytes;
-		float bytes_write = (stat.write.blocks * blocksize) - saved.write.bytes;
+		float bytes_read = (stat.read.blocks * sector_size) - saved.read.bytes;
+		float bytes_write = (stat.write.blocks * sector_size) - saved.write.bytes;
 		float time_read = stat.read.time - saved.read.time;
 		float time_write = stat.write.time - saved.write.time;
 
@@ -43,10 +158,10 @@
 		{
 			read = write = 0;
 
-			saved.read.bytes = ((float) stat.read.blocks) * blocksize;
+			saved.read.bytes = ((float) stat.read.blocks) * sector_size;
 			saved.read.time = stat.read.time;
 
-			saved.write.bytes = ((float) stat.write.blocks) * blocksize;
+			saved.write.bytes = ((float) stat.write.blocks) * sector_size;
 			saved.write.time = stat.write.time;
 		}
 
@@ -62,6 +177,20 @@
 			write = 0;
 		}
 
+		extend(stat);
+
+		history.read->push_back(read);
+		history.write->push_back(write);
+
+		// Keep the counters for the next run.
+		const double counters[] = {
+			saved.read.bytes,
+			(double) saved.read.time,
+			saved.write.bytes,
+			(double) saved.write.time
+		};
+		history.read->save(counters,4);
+
 	}
 
  }
@@ -27,13 +27,11 @@
  #include <udjat/agent.h>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/system/sampler.h>
 
  #include <memory>
 
- #ifdef HAVE_SYS_SYSINFO_H
- 	#include <sys/sysinfo.h>
- #endif // HAVE_SYS_SYSINFO_H
-
  using namespace std;
 
  namespace Udjat {
@@ -46,11 +44,10 @@
 	System::SwapUsage::SwapUsage(const char *name) : Agent<Percentage>{name} {
 	}
 
-	System::SwapUsage::SwapUsage(const XML::Node &node) : Agent<Percentage>{node} {
+	System::SwapUsage::SwapUsage(const XML::Node &node) : Agent<Percentage>{node}, history{node} {
 	}
 
 	System::SwapUsage::~SwapUsage() {
-
 	}
 
 	void System::SwapUsage::start() {
@@ -60,29 +57,93 @@
 
 	bool System::SwapUsage::refresh() {
 
-#ifdef HAVE_SYS_SYSINFO_H
+		// Driven by the agent update timer; agents refreshed on the same tick share
+		// one snapshot.
+		auto snapshot = Sampler::getInstance().get(timer() * 500);
+
+		bool rc = update(snapshot);
+		history.push_back((float) this->get(),snapshot.time);
+
+		return rc;
+	}
+
+	bool System::SwapUsage::update(const Snapshot &snapshot) {
+
+		try {
 
-		struct sysinfo info;
-		memset(&info,0,sizeof(info));
+			std::lock_guard<std::mutex> lock(guard);
+			swaps.refresh();
 
-		if(sysinfo(&info) < 0) {
-			throw system_error(errno,system_category(),_("Can't get system information"));
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error getting swap devices: ",e.what()}.error(name());
+
+		}
+
+		if(!snapshot.totalswap) {
+			// No swap.
+			return set(0);
 		}
 
-		float free = (float) info.freeswap;
-		float total = (float) info.totalswap;
+		float free = (float) snapshot.freeswap;
+		float total = (float) snapshot.totalswap;
 		float usage = (total-free) / total;
 
 		debug("Swap usage -----------> ",usage);
 
 		return set(usage);
-		
-#else
 
-		logger::String{"No support for sysinfo() function"}.error(name());
-		return set(0.0);
+	}
+
+	Udjat::Value & System::SwapUsage::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<Percentage>::getProperties(value);
+
+		{
+			std::lock_guard<std::mutex> lock(guard);
+
+			auto &devices = value["devices"];
+			for(size_t ix = 0; ix < swaps.devices.size(); ix++) {
+
+				const auto &device = swaps.devices[ix];
+
+				auto &row = devices[std::to_string(ix).c_str()];
+				row["name"] = device.name.c_str();
+				row["type"] = device.type.c_str();
+				row["size"] = device.size;
+				row["used"] = device.used;
+				row["priority"] = device.priority;
+
+				if(device.zram.valid) {
+					auto &zram = row["zram"];
+					zram["original"] = device.zram.original;
+					zram["compressed"] = device.zram.compressed;
+					zram["memory"] = device.zram.memory;
+					zram["ratio"] = device.zram.ratio;
+				}
+
+			}
+
+			auto &zswap = value["zswap"];
+			zswap["enabled"] = swaps.zswap.enabled;
+			zswap["compressor"] = swaps.zswap.compressor.c_str();
+			zswap["max-pool-percent"] = swaps.zswap.max_pool_percent;
+			zswap["pool"] = swaps.zswap.pool;
+			zswap["stored"] = swaps.zswap.stored;
+			zswap["ratio"] = swaps.zswap.ratio;
+			zswap["in"] = swaps.zswap.in;
+			zswap["out"] = swaps.zswap.out;
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
 
-#endif // HAVE_SYS_SYSINFO_H
+		return value;
 	}
 
 	static inline bool is_empty(const char *str) noexcept {
@@ -17,167 +17,175 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-/*
  #include <config.h>
  #include <udjat/defs.h>
 
- #include <iostream>
- #include <sstream>
- #include <fstream>
- #include <iomanip>
- #include <udjat/tools/system/stat.h>
  #include <udjat/agent/abstract.h>
- #include <udjat/moduleinfo.h>
-
- #include "private.h"
+ #include <udjat/agent/percentage.h>
+ #include <udjat/agent/sysstat.h>
+ #include <udjat/tools/system/stat.h>
+ #include <udjat/tools/system/cpuset.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/xml.h>
+ #include <private/cpusampler.h>
+ #include <memory>
 
  using namespace std;
 
  namespace Udjat {
 
-	static const Udjat::ModuleInfo moduleinfo{"Get System stats"};
-
-	class SysInfo::SysStat::Agent : public Abstract::Agent {
-	private:
-
-		/// @brief System stat state.
-		class State : public Udjat::State<float> {
-		private:
-			System::Stat::Type type = System::Stat::TOTAL;
-
-		public:
-			State(const xml_node &node) : Udjat::State<float>(node), type(System::Stat::TypeFactory(node)) {
-			}
-
-			inline System::Stat::Type getType() const noexcept {
-				return type;
-			}
-
-		};
+	class System::SysStat::State : public System::SysStat::BaseState {
+	public:
 
-		/// @brief Agent states.
-		std::vector<std::shared_ptr<State>> states;
+		/// @brief The state field.
+		const Stat::Type type;
 
-		/// @brief Selected type.
-		System::Stat::Type type = System::Stat::TOTAL;
+		State(const XML::Node &node, Stat::Type def) : BaseState{node}, type{node.attribute("field-name") ? Stat::TypeFactory(node) : def} {
+		}
 
-		/// @brief Saved values from last cycle.
-		System::Stat saved;
+	};
 
-		/// @brief Current values (in %).
-		float values[System::Stat::TOTAL];
+	std::shared_ptr<Abstract::Agent> System::SysStat::Factory::AgentFactory(const XML::Node &node) const {
+		debug("--- Building System Stat agent");
+		return std::make_shared<SysStat>(node);
+	}
 
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
 
-	protected:
+	System::SysStat::SysStat(const XML::Node &node) : Agent<Percentage>{node}, type{Stat::TypeFactory(node)}, history{node} {
+
+		// Optional cpu selection.
+		{
+			String cpuname{node,"cpu",""};
+			if(cpuname.empty() || !strcasecmp(cpuname.c_str(),"all")) {
+				cpu = -1;
+			} else if(!strcasecmp(cpuname.c_str(),"busiest")) {
+				cpu = -2;
+			} else {
+
+				size_t length = 0;
+				try {
+					cpu = std::stoi(cpuname,&length);
+				} catch(const std::exception &) {
+					length = 0;
+				}
 
-		float getValue(System::Stat::Type type) const noexcept {
+				if(!length || cpuname[length] || cpu < 0) {
+					throw system_error(EINVAL,system_category(),String{"Invalid cpu '",cpuname.c_str(),"', expecting 'all', 'busiest' or a cpu number"});
+				}
 
-			if(type < System::Stat::TOTAL) {
-				return values[type];
 			}
+		}
 
-			float total = 0;
-
-			for(size_t ix = 0; ix < N_ELEMENTS(values); ix++) {
-				total += values[ix];
-			}
+		Object::properties.icon = "utilities-system-monitor";
 
-			return total - values[System::Stat::IDLE];
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = Stat::getLabel(type);
+		}
 
+		if(is_empty(Object::properties.summary)) {
+			Object::properties.summary = Stat::getSummary(type);
 		}
 
-		std::shared_ptr<Abstract::State> computeState() override {
+	}
 
-			for(auto state : states) {
+	System::SysStat::~SysStat() {
+		CpuSampler::getInstance().remove(this);
+	}
 
-				if(state->compare(getValue(state->getType()) * 100)) {
-					return state;
-				}
+	void System::SysStat::start() {
 
-			}
+		// The sampler keeps the /proc/stat deltas at the agent rate; the values are
+		// published by the agent update timer.
+		CpuSampler::getInstance().push_back(this,timer() * 1000);
 
-			return Abstract::Agent::computeState();
-		}
+		Abstract::Agent::start();
+	}
 
+	void System::SysStat::stop() {
+		CpuSampler::getInstance().remove(this);
+		Abstract::Agent::stop();
+	}
 
-	public:
-		Agent(const xml_node &node) : Abstract::Agent(node), type(System::Stat::TypeFactory(node)) {
+	bool System::SysStat::refresh() {
 
-			Object::properties.icon = "utilities-system-monitor";
-			Object::properties.summary = System::Stat::getSummary(this->type);
-			Object::properties.label = System::Stat::getLabel(this->type);
+		// No I/O here, get values from the shared sampler.
+		bool rc = set(CpuSampler::getInstance().get(type,cpu));
+		history.push_back((float) this->get());
 
-			if(!timer()) {
-				throw runtime_error("System stats requires an update timer");
-			}
+		// The states on other fields can change with the same agent value.
+		if(!rc && foreign) {
+			updated(true);
+		}
 
-			for(size_t ix = 0; ix < N_ELEMENTS(values); ix++) {
-				values[ix] = 0;
-			}
+		return rc;
 
-		}
+	}
 
-		Value & get(Value &value) const override {
-			value.setFraction(getValue(this->type));
-			return value;
-		}
+	Udjat::Value & System::SysStat::getProperties(Udjat::Value &value) const noexcept {
 
+		Agent<Percentage>::getProperties(value);
 
-		Udjat::Value & getProperties(Udjat::Value &value) const noexcept override {
+		try {
 
-			super::getProperties(value);
+			auto &sampler = CpuSampler::getInstance();
 
-			auto &cpu = value["cpu"];
-			for(size_t ix = 0; ix < N_ELEMENTS(values); ix++) {
-				(cpu[std::to_string((System::Stat::Type) ix)]).setFraction(values[ix]);
+			auto &fields = value["cpu"];
+			for(size_t ix = 0; ix <= Stat::TOTAL; ix++) {
+				fields[std::to_string((Stat::Type) ix)].setFraction(sampler.get((Stat::Type) ix,cpu));
 			}
 
-			return value;
-		}
-
-		std::string to_string() const noexcept override {
-			std::stringstream out;
-			out << std::fixed << std::setprecision(2) << (getValue(this->type) * 100) << "%";
-			return out.str();
-		}
+			sampler.get([&value](const CpuSet::Usage &usage){
+				auto &cores = value["cores"];
+				for(size_t ix = 0; ix < usage.count; ix++) {
+					if(usage.valid[ix]) {
+						cores[std::to_string(ix).c_str()].setFraction(usage.busy[ix]);
+					}
+				}
+			});
 
-		bool refresh() override {
+		} catch(const std::exception &e) {
 
-			System::Stat current;
-			System::Stat diff(current);
+			Logger::String{"Error getting cpu properties: ",e.what()}.error(name());
 
-			diff -= this->saved;	// Get only the difference.
-			this->saved = current;	// Update saved value.
+		}
 
-			float total = (float) diff.total();
-			for(size_t ix = 0; ix < N_ELEMENTS(values); ix++) {
-				values[ix] = ((float) diff[(System::Stat::Type) ix]) / total;
-#ifdef DEBUG
-				cout << ((System::Stat::Type) ix) << " = " << fixed << setprecision(2) << (values[ix] * 100) << " %" << endl;
-#endif // DEBUG
+		if(history) {
+			try {
+				history.properties(value["history"],true);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
 			}
-
-			updated(true);
-			return true;
 		}
 
-		std::shared_ptr<Abstract::State> StateFactory(const pugi::xml_node &node) override {
-			auto state = std::make_shared<State>(node);
-			states.push_back(state);
-			return state;
-		}
+		return value;
+	}
 
-	};
+	std::shared_ptr<Abstract::State> System::SysStat::StateFactory(const XML::Node &node) {
 
-	SysInfo::SysStat::SysStat() : Udjat::Factory("system-stat",moduleinfo) {
+		auto state = std::make_shared<State>(node,type);
+		watches.push_back(state);
+		if(state->type != type) {
+			foreign++;
+		}
+		return state;
 	}
 
-	SysInfo::SysStat::~SysStat() {
-	}
+	std::shared_ptr<Abstract::State> System::SysStat::computeState() {
+
+		auto &sampler = CpuSampler::getInstance();
+
+		for(auto state : watches) {
+			if(state->compare(sampler.get(state->type,cpu))) {
+				return state;
+			}
+		}
 
-	std::shared_ptr<Abstract::Agent> SysInfo::SysStat::AgentFactory(const pugi::xml_node &node)  const {
-		return make_shared<Agent>(node);
+		return Abstract::Agent::computeState();
 	}
 
  }
-*/
@@ -25,7 +25,7 @@
  #include <udjat/agent/uptime.h>
 
  #ifdef HAVE_SYS_SYSINFO_H
- 	#include <sys/sysinfo.h>
+ 	#include <udjat/tools/system/sampler.h>
  #endif // HAVE_SYS_SYSINFO_H
 
  namespace Udjat {
@@ -66,12 +66,8 @@
 
 #if defined(HAVE_SYS_SYSINFO_H)
 
-	struct sysinfo info;
-	memset(&info,0,sizeof(info));
-	if(sysinfo(&info) < 0) {
-		throw std::system_error(errno,std::system_category(),_("Can't get system information"));
-	}
-	return info.uptime;
+	// Uptime has a resolution of one second, share the last snapshot.
+	return (time_t) Sampler::getInstance().get(1000).uptime;
 
 #elif defined(_WIN32)
 
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/action.h>
+ #include <udjat/tools/actions/vmstat.h>
+ #include <udjat/tools/response.h>
+ #include <udjat/tools/report.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/system/vmstat.h>
+ #include <memory>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	std::shared_ptr<Udjat::Action> VmStat::Action::Factory::ActionFactory(const XML::Node &node) const {
+		return make_shared<VmStat::Action>(node);
+	}
+
+	VmStat::Action::Action(const XML::Node &node) : Udjat::Action{node}, max_age{node.attribute("max-age").as_uint(1000)} {
+
+		// First read, the rates are available on the next one.
+		auto &counters = System::VmCounters::getInstance();
+		counters.refresh();
+		rates.update(counters);
+
+	}
+
+	VmStat::Action::~Action() {
+	}
+
+	/// @brief Fill report row.
+	static void row(const System::VmCounters &counters, const System::VmCounters::Rates &rates, System::VmCounters::Counter counter, Udjat::Value &value) {
+		value["counter"] = System::VmCounters::name(counter);
+		value["rate"] = rates[counter];
+		value["total"] = counters.total(counter);
+	}
+
+	int VmStat::Action::call(Udjat::Request &request, Udjat::Response &response, bool except) {
+
+		return exec(response,except,[&]() -> int {
+
+			auto &counters = System::VmCounters::getInstance();
+			counters.refresh(max_age);
+			rates.update(counters);
+
+			// Get first line.
+			Value value;
+			row(counters,rates,(System::VmCounters::Counter) 0,value);
+
+			auto &report = response.ReportFactory(value);
+
+			for(size_t ix = 1; ix < System::VmCounters::COUNT; ix++) {
+				value.clear();
+				row(counters,rates,(System::VmCounters::Counter) ix,value);
+				report << value;
+			}
+
+			return 0;
+
+		});
+
+	}
+
+ }
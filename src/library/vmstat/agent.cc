@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/agent/vmstat.h>
+ #include <udjat/tools/system/vmstat.h>
+ #include <udjat/tools/intl.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/xml.h>
+ #include <memory>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	class System::VmStat::State : public Udjat::State<float> {
+	private:
+
+		/// @brief The watched counter.
+		VmCounters::Counter counter;
+
+	public:
+		State(const XML::Node &node, VmCounters::Counter def)
+			: Udjat::State<float>{node}, counter{node.attribute("field-name") ? VmCounters::CounterFactory(node) : def} {
+		}
+
+		inline VmCounters::Counter field() const noexcept {
+			return counter;
+		}
+
+	};
+
+	std::shared_ptr<Abstract::Agent> System::VmStat::Factory::AgentFactory(const XML::Node &node) const {
+		return std::make_shared<VmStat>(node);
+	}
+
+	static inline bool is_empty(const char *str) noexcept {
+		return !(str && *str);
+	}
+
+	System::VmStat::VmStat(const XML::Node &node) : Agent<float>{node}, counter{VmCounters::CounterFactory(node)}, history{node} {
+
+		Object::properties.icon = "utilities-system-monitor";
+
+		if(is_empty(Object::properties.label)) {
+			Object::properties.label = VmCounters::name(counter);
+		}
+
+	}
+
+	System::VmStat::~VmStat() {
+	}
+
+	void System::VmStat::start() {
+
+		// First read, the rates are available on the next one.
+		auto &counters = VmCounters::getInstance();
+		counters.refresh();
+		rates.update(counters);
+
+		Abstract::Agent::start();
+	}
+
+	bool System::VmStat::refresh() {
+
+		auto &counters = VmCounters::getInstance();
+
+		// Driven by the agent update timer; agents refreshed on the same tick share the read.
+		counters.refresh(timer() * 500);
+		rates.update(counters);
+
+		bool rc = set(rates[counter]);
+		history.push_back(this->get());
+
+		if(!rc && !watches.empty()) {
+			// The states may watch other counters, evaluate them even if the value is the same.
+			updated(true);
+		}
+
+		return rc;
+
+	}
+
+	Udjat::Value & System::VmStat::getProperties(Udjat::Value &value) const noexcept {
+
+		Agent<float>::getProperties(value);
+
+		try {
+
+			auto &counters = VmCounters::getInstance();
+
+			auto &values = value["rates"];
+			auto &totals = value["totals"];
+			for(size_t ix = 0; ix < VmCounters::COUNT; ix++) {
+				values[VmCounters::name((VmCounters::Counter) ix)] = rates[(VmCounters::Counter) ix];
+				totals[VmCounters::name((VmCounters::Counter) ix)] = counters.total((VmCounters::Counter) ix);
+			}
+
+			value["efficiency"].setFraction(rates.efficiency());
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error getting vmstat properties: ",e.what()}.error(name());
+
+		}
+
+		if(history) {
+			try {
+				history.properties(value["history"]);
+			} catch(const std::exception &e) {
+				Logger::String{"Error getting history: ",e.what()}.error(name());
+			}
+		}
+
+		return value;
+	}
+
+	std::shared_ptr<Abstract::State> System::VmStat::StateFactory(const XML::Node &node) {
+		// The agent counter is the default.
+		auto state = std::make_shared<State>(node,counter);
+		watches.push_back(state);
+		return state;
+	}
+
+	std::shared_ptr<Abstract::State> System::VmStat::computeState() {
+
+		for(auto state : watches) {
+			if(state->compare(rates[state->field()])) {
+				return state;
+			}
+		}
+
+		return Abstract::Agent::computeState();
+	}
+
+ }